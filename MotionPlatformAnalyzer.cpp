@@ -0,0 +1,390 @@
+/** @file
+	@brief Frequency-domain analysis of a recording: power spectra of every
+	channel, and latency and transfer function from the commanded target
+	angles to the reported pose.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformRecording.h"
+#include "MotionPlatformSpectrum.h"
+
+// Library/third-party includes
+#include <boost/bind/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <boost/ptr_container/ptr_vector.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+	typedef boost::chrono::steady_clock Clock;
+	typedef std::vector<std::pair<std::size_t, std::size_t> > PairList;
+
+	/// rms below which a channel counts as silent; pairing two real channels
+	/// in one transform leaks rounding noise of this order into silent ones
+	const double SILENT_RMS = 1e-9;
+
+	/// the six actuator channels, then the pose as euler angles
+	const std::size_t POSE_CHANNEL = motionplatform::Simulation::ACTUATOR_COUNT;
+	const std::size_t CHANNEL_COUNT = POSE_CHANNEL + 3;
+	const char *const CHANNEL_NAMES[CHANNEL_COUNT] = {
+		"target_displacement.x", "target_displacement.y", "target_displacement.z",
+		"target_angle.x", "target_angle.y", "target_angle.z",
+		"pose.pitch", "pose.yaw", "pose.roll"
+	};
+
+	struct Options {
+		Options() : seat(0), segment(1024), threads(boost::thread::hardware_concurrency()),
+			rateHz(1000), maxAngle(45), maxLagMs(250) {}
+		std::string input;
+		std::size_t seat;
+		std::size_t segment;
+		std::size_t threads;
+		double rateHz; ///< used when the recording was made unpaced
+		double maxAngle; ///< scales the pose to the target_angle channels
+		double maxLagMs;
+		std::string csvFile; ///< empty for no per-bin output
+	};
+
+	void printUsage() {
+		std::cerr << "Usage: MotionPlatformAnalyzer [options] RECORDING\n"
+			"  --seat N         seat to analyze (default 0)\n"
+			"  --segment N      samples per FFT segment, a power of two (default 1024)\n"
+			"  --threads N      FFT worker threads (default: one per core)\n"
+			"  --rate HZ        sample rate of recordings made unpaced (default 1000)\n"
+			"  --max-angle DEG  angle that target_angle 1.0 stands for (default 45)\n"
+			"  --max-lag MS     latency search range (default 250)\n"
+			"  --csv FILE       write every frequency bin to FILE\n";
+	}
+
+	bool parseOptions(int argc, char *argv[], Options &opts) {
+		try {
+			for (int i = 1; i < argc; ++i) {
+				std::string arg(argv[i]);
+				if (arg.compare(0, 2, "--") != 0) {
+					if (!opts.input.empty()) {
+						return false;
+					}
+					opts.input = arg;
+					continue;
+				}
+				if (i + 1 >= argc) {
+					return false;
+				}
+				std::string value(argv[++i]);
+				if (arg == "--seat") {
+					opts.seat = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--segment") {
+					opts.segment = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--threads") {
+					opts.threads = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--rate") {
+					opts.rateHz = boost::lexical_cast<double>(value);
+				} else if (arg == "--max-angle") {
+					opts.maxAngle = boost::lexical_cast<double>(value);
+				} else if (arg == "--max-lag") {
+					opts.maxLagMs = boost::lexical_cast<double>(value);
+				} else if (arg == "--csv") {
+					opts.csvFile = value;
+				} else {
+					return false;
+				}
+			}
+		} catch (boost::bad_lexical_cast const &) {
+			return false;
+		}
+		const bool powerOfTwo = opts.segment >= 16 && (opts.segment & (opts.segment - 1)) == 0;
+		return !opts.input.empty() && powerOfTwo && opts.rateHz > 0 && opts.maxAngle > 0 && opts.maxLagMs >= 0;
+	}
+
+	/// @brief Hands full segments from the reader to the FFT workers.
+	///
+	/// Segments travel in a fixed set of buffers: the reader blocks while
+	/// all of them are queued or being transformed, so memory stays
+	/// constant however long the recording is.
+	class SegmentQueue {
+	public:
+		SegmentQueue(std::size_t buffers, std::size_t bufferSize)
+			: m_storage(buffers, std::vector<double>(bufferSize)), m_closed(false) {
+			for (std::size_t i = 0; i < buffers; ++i) {
+				m_free.push_back(&m_storage[i]);
+			}
+		}
+
+		/// @brief An empty buffer for the reader to fill.
+		std::vector<double> *acquire() {
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (m_free.empty()) {
+				m_changed.wait(lock);
+			}
+			std::vector<double> *buffer = m_free.back();
+			m_free.pop_back();
+			return buffer;
+		}
+
+		void submit(std::vector<double> *buffer) {
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_ready.push_back(buffer);
+			m_changed.notify_all();
+		}
+
+		/// @brief The next full buffer, or NULL once closed and drained.
+		std::vector<double> *take() {
+			boost::unique_lock<boost::mutex> lock(m_mutex);
+			while (m_ready.empty() && !m_closed) {
+				m_changed.wait(lock);
+			}
+			if (m_ready.empty()) {
+				return NULL;
+			}
+			std::vector<double> *buffer = m_ready.front();
+			m_ready.pop_front();
+			return buffer;
+		}
+
+		void release(std::vector<double> *buffer) {
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_free.push_back(buffer);
+			m_changed.notify_all();
+		}
+
+		/// @brief No more segments are coming.
+		void close() {
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_closed = true;
+			m_changed.notify_all();
+		}
+
+	private:
+		std::vector<std::vector<double> > m_storage;
+		std::vector<std::vector<double> *> m_free;
+		std::deque<std::vector<double> *> m_ready;
+		bool m_closed;
+		boost::mutex m_mutex;
+		boost::condition_variable m_changed;
+	};
+
+	/*
+	 * Transform segments until the queue runs dry, into the worker's own
+	 * accumulator
+	 */
+	void workerMain(SegmentQueue &queue, motionplatform::Fft const &fft, std::vector<double> const &window,
+		motionplatform::WelchAccumulator &spectra) {
+		while (std::vector<double> *buffer = queue.take()) {
+			spectra.add(fft, window, &(*buffer)[0]);
+			queue.release(buffer);
+		}
+	}
+
+	/*
+	 * Bin with the most power in @p channel, skipping DC
+	 */
+	std::size_t peakBin(motionplatform::WelchAccumulator const &spectra, std::size_t channel) {
+		std::size_t best = 1;
+		for (std::size_t k = 2; k < spectra.bins(); ++k) {
+			if (spectra.power(channel, k) > spectra.power(channel, best)) {
+				best = k;
+			}
+		}
+		return best;
+	}
+
+	double coherence(motionplatform::WelchAccumulator const &spectra, PairList const &pairs, std::size_t p, std::size_t k) {
+		const double denominator = spectra.power(pairs[p].first, k) * spectra.power(pairs[p].second, k);
+		return denominator > 0 ? std::norm(spectra.cross(p, k)) / denominator : 0.0;
+	}
+
+	bool writeCsv(std::string const &path, motionplatform::WelchAccumulator const &spectra, PairList const &pairs,
+		double rateHz, std::size_t segment, std::vector<double> const &window) {
+		std::FILE *file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			return false;
+		}
+		std::fprintf(file, "hz");
+		for (std::size_t c = 0; c < CHANNEL_COUNT; ++c) {
+			std::fprintf(file, ",psd %s", CHANNEL_NAMES[c]);
+		}
+		for (std::size_t p = 0; p < pairs.size(); ++p) {
+			const char *response = CHANNEL_NAMES[pairs[p].second];
+			std::fprintf(file, ",gain %s,phase %s,coherence %s", response, response, response);
+		}
+		std::fprintf(file, "\n");
+		const double toDegrees = 180.0 / boost::math::constants::pi<double>();
+		for (std::size_t k = 0; k < spectra.bins(); ++k) {
+			std::fprintf(file, "%g", k * rateHz / segment);
+			for (std::size_t c = 0; c < CHANNEL_COUNT; ++c) {
+				std::fprintf(file, ",%g", spectra.psd(c, k, rateHz, window));
+			}
+			for (std::size_t p = 0; p < pairs.size(); ++p) {
+				const double input = spectra.power(pairs[p].first, k);
+				/// H = Sxy / Sxx, the estimate that is unbiased by noise on the response
+				const motionplatform::Complex h = input > 0 ? spectra.cross(p, k) / input : motionplatform::Complex();
+				std::fprintf(file, ",%g,%g,%g", std::abs(h), std::arg(h) * toDegrees, coherence(spectra, pairs, p, k));
+			}
+			std::fprintf(file, "\n");
+		}
+		return std::fclose(file) == 0;
+	}
+
+	int run(Options const &opts) {
+		motionplatform::RecordingReader reader(opts.input);
+		if (!reader.isOpen()) {
+			std::cerr << "MPS_ANALYZER > Could not read recording " << opts.input << std::endl;
+			return 1;
+		}
+		if (opts.seat >= reader.header().seatCount) {
+			std::cerr << "MPS_ANALYZER > The recording has " << reader.header().seatCount << " seats" << std::endl;
+			return 1;
+		}
+		const double rateHz = reader.header().rateHz ? reader.header().rateHz : opts.rateHz;
+		const std::size_t segment = opts.segment;
+		/// segments overlap by half, the usual choice for a Hann window
+		const std::size_t hop = segment / 2;
+		const std::size_t workers = std::max<std::size_t>(opts.threads, 1);
+
+		PairList pairs;
+		for (std::size_t axis = 0; axis < 3; ++axis) {
+			pairs.push_back(std::make_pair(motionplatform::Simulation::TARGET_ANGLE_CHANNEL + axis, POSE_CHANNEL + axis));
+		}
+		motionplatform::Fft fft(segment);
+		const std::vector<double> window = motionplatform::hannWindow(segment);
+		boost::ptr_vector<motionplatform::WelchAccumulator> spectra;
+		for (std::size_t i = 0; i < workers; ++i) {
+			spectra.push_back(new motionplatform::WelchAccumulator(CHANNEL_COUNT, segment, pairs));
+		}
+		SegmentQueue queue(2 * workers, CHANNEL_COUNT * segment);
+		boost::thread_group threads;
+		for (std::size_t i = 0; i < workers; ++i) {
+			threads.create_thread(boost::bind(&workerMain, boost::ref(queue), boost::cref(fft),
+				boost::cref(window), boost::ref(spectra[i])));
+		}
+
+		const Clock::time_point start = Clock::now();
+		/// the last segment's worth of samples, channel after channel
+		std::vector<double> history(CHANNEL_COUNT * segment);
+		std::size_t filled = 0;
+		boost::uint64_t samples = 0;
+		std::vector<motionplatform::SampleRecord> block;
+		while (reader.readBlock(block)) {
+			for (std::size_t i = 0; i < block.size(); ++i) {
+				motionplatform::SampleRecord const &record = block[i];
+				if (record.seat != opts.seat) {
+					continue;
+				}
+				for (std::size_t c = 0; c < POSE_CHANNEL; ++c) {
+					history[c * segment + filled] = record.actuators[c];
+				}
+				double pose[3];
+				motionplatform::toEuler(record.orientation, pose[0], pose[1], pose[2]);
+				for (std::size_t axis = 0; axis < 3; ++axis) {
+					history[(POSE_CHANNEL + axis) * segment + filled] = pose[axis] / opts.maxAngle;
+				}
+				++samples;
+				if (++filled == segment) {
+					std::vector<double> *buffer = queue.acquire();
+					std::copy(history.begin(), history.end(), buffer->begin());
+					queue.submit(buffer);
+					for (std::size_t c = 0; c < CHANNEL_COUNT; ++c) {
+						std::copy(history.begin() + c * segment + hop, history.begin() + (c + 1) * segment,
+							history.begin() + c * segment);
+					}
+					filled -= hop;
+				}
+			}
+		}
+		queue.close();
+		threads.join_all();
+		for (std::size_t i = 1; i < workers; ++i) {
+			spectra[0].merge(spectra[i]);
+		}
+		motionplatform::WelchAccumulator const &total = spectra[0];
+		const double seconds = boost::chrono::duration<double>(Clock::now() - start).count();
+		std::cerr << "MPS_ANALYZER > " << samples << " samples in " << seconds << " s on " << workers
+			<< " threads: " << samples / std::max(seconds, 1e-9) << " samples/s" << std::endl;
+		if (total.segments() == 0) {
+			std::cerr << "MPS_ANALYZER > Fewer than " << segment << " samples of seat " << opts.seat << std::endl;
+			return 1;
+		}
+
+		const double binHz = rateHz / segment;
+		std::printf("seat %u, %llu samples at %g Hz, %llu segments of %u (%g Hz bins)\n\n",
+			static_cast<unsigned>(opts.seat), static_cast<unsigned long long>(samples), rateHz,
+			static_cast<unsigned long long>(total.segments()), static_cast<unsigned>(segment), binHz);
+		std::printf("%-22s %12s %10s\n", "channel", "rms", "peak hz");
+		for (std::size_t c = 0; c < CHANNEL_COUNT; ++c) {
+			double variance = 0;
+			for (std::size_t k = 0; k < total.bins(); ++k) {
+				variance += total.psd(c, k, rateHz, window) * binHz;
+			}
+			const double rms = std::sqrt(variance);
+			if (rms > SILENT_RMS) {
+				std::printf("%-22s %12.6f %10.3f\n", CHANNEL_NAMES[c], rms, peakBin(total, c) * binHz);
+			} else {
+				std::printf("%-22s %12.6f %10s\n", CHANNEL_NAMES[c], 0.0, "-");
+			}
+		}
+		std::printf("\n%-22s %12s %10s %10s %10s %10s\n", "response", "latency ms", "at hz", "gain", "phase deg", "coherence");
+		const std::size_t maxLag = static_cast<std::size_t>(opts.maxLagMs * rateHz / 1000.0);
+		for (std::size_t p = 0; p < pairs.size(); ++p) {
+			/// transfer function where the command has the most power
+			const std::size_t k = peakBin(total, pairs[p].first);
+			const double input = total.power(pairs[p].first, k);
+			if (std::sqrt(input) <= SILENT_RMS) {
+				std::printf("%-22s %12s\n", CHANNEL_NAMES[pairs[p].second], "no command");
+				continue;
+			}
+			const double latencyMs = total.latency(fft, p, maxLag) * 1000.0 / rateHz;
+			const motionplatform::Complex h = total.cross(p, k) / input;
+			std::printf("%-22s %12.3f %10.3f %10.4f %10.2f %10.4f\n", CHANNEL_NAMES[pairs[p].second], latencyMs,
+				k * binHz, std::abs(h), std::arg(h) * 180.0 / boost::math::constants::pi<double>(),
+				coherence(total, pairs, p, k));
+		}
+		if (!opts.csvFile.empty() && !writeCsv(opts.csvFile, total, pairs, rateHz, segment, window)) {
+			std::cerr << "MPS_ANALYZER > Could not write " << opts.csvFile << std::endl;
+			return 1;
+		}
+		return 0;
+	}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		printUsage();
+		return 1;
+	}
+	return run(opts);
+}
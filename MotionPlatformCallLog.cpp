@@ -0,0 +1,278 @@
+/** @file
+	@brief Implementation of the device call log.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformCallLog.h"
+#include "MotionPlatformFile.h"
+
+// Library/third-party includes
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/thread/lock_guard.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace motionplatform {
+
+	namespace ipc = boost::interprocess;
+
+	namespace {
+
+		/// pose arguments: sensor, reserved, then the values
+		const std::size_t POSE_SIZE = 8 + CALL_POSE_VALUES * sizeof(double);
+
+		inline std::size_t padded(std::size_t size) { return (sizeof(CallHeader) + size + 7) & ~std::size_t(7); }
+
+	} // namespace
+
+	CallLogWriter::CallLogWriter(std::string const &path, std::size_t initialBytes)
+		: m_path(path), m_start(Clock::now()), m_capacity(0), m_used(sizeof(CallLogHeader)), m_dropped(0) {
+		std::FILE *file = std::fopen(path.c_str(), "wb");
+		if (!file) {
+			return;
+		}
+		std::fclose(file);
+		if (!grow(initialBytes)) {
+			return;
+		}
+		CallLogHeader *header = static_cast<CallLogHeader *>(m_region.get_address());
+		std::memcpy(header->magic, CALL_LOG_MAGIC, sizeof(header->magic));
+		header->version = CALL_LOG_VERSION;
+		header->headerSize = sizeof(CallLogHeader);
+		header->committedBytes = m_used;
+	}
+
+	CallLogWriter::~CallLogWriter() {
+		if (!isOpen()) {
+			return;
+		}
+		m_region.flush();
+		ipc::mapped_region unmapped;
+		m_region.swap(unmapped);
+#if defined(__unix__)
+		/// readers stop at committedBytes, so a file left at full size still reads
+		if (truncate(m_path.c_str(), static_cast<off_t>(m_used)) != 0) {
+			std::perror("MotionPlatformCallLog");
+		}
+#endif
+	}
+
+	void CallLogWriter::descriptor(std::size_t seat, const char *json, std::size_t length) {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		if (unsigned char *arguments = append(CALL_DESCRIPTOR, seat, length)) {
+			std::memcpy(arguments, json, length);
+			commit();
+		}
+	}
+
+	void CallLogWriter::pose(std::size_t seat, boost::uint32_t sensor, const double *pose) {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		if (unsigned char *arguments = append(CALL_POSE, seat, POSE_SIZE)) {
+			std::memcpy(arguments, &sensor, sizeof(sensor));
+			std::memcpy(arguments + 8, pose, CALL_POSE_VALUES * sizeof(double));
+			commit();
+		}
+	}
+
+	void CallLogWriter::analog(std::size_t seat, const double *values, std::size_t count) {
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		if (unsigned char *arguments = append(CALL_ANALOG, seat, count * sizeof(double))) {
+			std::memcpy(arguments, values, count * sizeof(double));
+			commit();
+		}
+	}
+
+	/*
+	 * Claim room for a call of @p size argument bytes and fill in its
+	 * header; called with the lock held. Readers do not see the call until
+	 * the caller has filled the arguments and called commit().
+	 */
+	unsigned char *CallLogWriter::append(boost::uint16_t kind, std::size_t seat, std::size_t size) {
+		if (!isOpen()) {
+			return NULL;
+		}
+		const std::size_t length = padded(size);
+		if (m_used + length > m_capacity && !grow(length)) {
+			++m_dropped;
+			return NULL;
+		}
+		unsigned char *base = static_cast<unsigned char *>(m_region.get_address());
+		CallHeader call;
+		call.timeNsec = static_cast<boost::uint64_t>(
+			boost::chrono::duration_cast<boost::chrono::nanoseconds>(Clock::now() - m_start).count());
+		call.size = static_cast<boost::uint32_t>(size);
+		call.kind = kind;
+		call.seat = static_cast<boost::uint16_t>(seat);
+		std::memcpy(base + m_used, &call, sizeof(call));
+		unsigned char *arguments = base + m_used + sizeof(call);
+		m_used += length;
+		return arguments;
+	}
+
+	/*
+	 * Publish the call append() reserved, once its arguments are written
+	 */
+	void CallLogWriter::commit() {
+		static_cast<CallLogHeader *>(m_region.get_address())->committedBytes = m_used;
+	}
+
+	/*
+	 * Make room for @p needed more bytes: extend the file (new bytes read
+	 * as zeros) and map all of it again
+	 */
+	bool CallLogWriter::grow(std::size_t needed) {
+		const std::size_t capacity = std::max(m_capacity * 2, m_used + needed);
+		std::FILE *file = std::fopen(m_path.c_str(), "r+b");
+		if (!file) {
+			return false;
+		}
+		const bool extended = seekFile(file, static_cast<boost::int64_t>(capacity - 1), SEEK_SET) &&
+			std::fputc(0, file) != EOF;
+		if (std::fclose(file) != 0 || !extended) {
+			return false;
+		}
+		try {
+			ipc::file_mapping mapping(m_path.c_str(), ipc::read_write);
+			ipc::mapped_region region(mapping, ipc::read_write, 0, capacity);
+			m_region.swap(region);
+		} catch (ipc::interprocess_exception const &) {
+			return false;
+		}
+		m_capacity = capacity;
+		return true;
+	}
+
+	CallLogReader::CallLogReader(std::string const &path)
+		: m_begin(NULL), m_end(0), m_offset(0), m_truncated(false) {
+		try {
+			ipc::file_mapping mapping(path.c_str(), ipc::read_only);
+			ipc::mapped_region region(mapping, ipc::read_only);
+			m_region.swap(region);
+		} catch (ipc::interprocess_exception const &) {
+			return;
+		}
+		if (m_region.get_size() < sizeof(CallLogHeader)) {
+			return;
+		}
+		m_begin = static_cast<const unsigned char *>(m_region.get_address());
+		CallLogHeader header;
+		std::memcpy(&header, m_begin, sizeof(header));
+		if (std::memcmp(header.magic, CALL_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+			header.version != CALL_LOG_VERSION || header.headerSize < sizeof(CallLogHeader)) {
+			return;
+		}
+		m_offset = header.headerSize;
+		m_end = static_cast<std::size_t>(std::min<boost::uint64_t>(header.committedBytes, m_region.get_size()));
+	}
+
+	bool CallLogReader::next(CallView &call) {
+		if (m_offset + sizeof(CallHeader) > m_end) {
+			m_truncated = m_offset < m_end;
+			return false;
+		}
+		CallHeader header;
+		std::memcpy(&header, m_begin + m_offset, sizeof(header));
+		const std::size_t length = padded(header.size);
+		if (m_offset + length > m_end) {
+			m_truncated = true;
+			return false;
+		}
+		call.timeNsec = header.timeNsec;
+		call.kind = header.kind;
+		call.seat = header.seat;
+		call.size = header.size;
+		call.arguments = m_begin + m_offset + sizeof(header);
+		m_offset += length;
+		return true;
+	}
+
+	bool replayCalls(CallLogReader &log, CallSink &sink) {
+		CallView call;
+		while (log.next(call)) {
+			switch (call.kind) {
+			case CALL_DESCRIPTOR:
+				sink.descriptor(call.seat, reinterpret_cast<const char *>(call.arguments), call.size);
+				break;
+			case CALL_POSE: {
+				if (call.size != POSE_SIZE) {
+					return false;
+				}
+				boost::uint32_t sensor;
+				std::memcpy(&sensor, call.arguments, sizeof(sensor));
+				/// calls are 8-byte aligned in the log, so the values are too
+				sink.pose(call.seat, sensor, reinterpret_cast<const double *>(call.arguments + 8));
+				break;
+			}
+			case CALL_ANALOG:
+				if (call.size % sizeof(double) != 0) {
+					return false;
+				}
+				sink.analog(call.seat, reinterpret_cast<const double *>(call.arguments), call.size / sizeof(double));
+				break;
+			default:
+				return false;
+			}
+		}
+		return !log.truncated();
+	}
+
+	DigestSink::DigestSink()
+		: m_digest(14695981039346656037ULL), m_descriptors(0), m_poses(0), m_analogs(0) {}
+
+	void DigestSink::descriptor(std::size_t seat, const char *json, std::size_t length) {
+		const boost::uint16_t head[2] = { CALL_DESCRIPTOR, static_cast<boost::uint16_t>(seat) };
+		mix(head, sizeof(head));
+		mix(json, length);
+		++m_descriptors;
+	}
+
+	void DigestSink::pose(std::size_t seat, boost::uint32_t sensor, const double *pose) {
+		const boost::uint16_t head[2] = { CALL_POSE, static_cast<boost::uint16_t>(seat) };
+		mix(head, sizeof(head));
+		mix(&sensor, sizeof(sensor));
+		mix(pose, CALL_POSE_VALUES * sizeof(double));
+		++m_poses;
+	}
+
+	void DigestSink::analog(std::size_t seat, const double *values, std::size_t count) {
+		const boost::uint16_t head[2] = { CALL_ANALOG, static_cast<boost::uint16_t>(seat) };
+		mix(head, sizeof(head));
+		mix(values, count * sizeof(double));
+		++m_analogs;
+	}
+
+	void DigestSink::mix(const void *data, std::size_t size) {
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+		for (std::size_t i = 0; i < size; ++i) {
+			m_digest = (m_digest ^ bytes[i]) * 1099511628211ULL;
+		}
+	}
+
+} // namespace motionplatform
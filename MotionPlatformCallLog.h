@@ -0,0 +1,185 @@
+/** @file
+	@brief Capture log of the device calls the plugin makes towards the
+	server, and replay of such a log into a sink.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformCallLog_h_GUID_74F5AA3D_2D46_468B_BBA3_292F2266AE86
+#define INCLUDED_MotionPlatformCallLog_h_GUID_74F5AA3D_2D46_468B_BBA3_292F2266AE86
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+
+namespace motionplatform {
+
+	/// @brief Call log layout: one CallLogHeader, then one CallHeader per
+	/// call followed by its arguments, padded to 8 bytes.
+	///
+	/// - CALL_DESCRIPTOR: the JSON text
+	/// - CALL_POSE: a 32-bit sensor, 32 reserved bits, then CALL_POSE_VALUES
+	///   doubles laid out as OSVR_PoseState (translation x, y, z, rotation
+	///   w, x, y, z)
+	/// - CALL_ANALOG: the channel values as doubles
+	///
+	/// Host byte order, like recordings. committedBytes is updated after
+	/// each call is complete, so a log cut short by a crash still reads up
+	/// to its last whole call.
+	struct CallLogHeader {
+		char magic[8];
+		boost::uint32_t version;
+		boost::uint32_t headerSize;
+		boost::uint64_t committedBytes; ///< from the file start, this header included
+	};
+
+	struct CallHeader {
+		boost::uint64_t timeNsec; ///< since the log was opened
+		boost::uint32_t size; ///< of the arguments, before padding
+		boost::uint16_t kind;
+		boost::uint16_t seat;
+	};
+
+	static const char CALL_LOG_MAGIC[8] = { 'M', 'P', 'S', 'C', 'A', 'L', 'L', '\0' };
+	static const boost::uint32_t CALL_LOG_VERSION = 1;
+	static const boost::uint16_t CALL_DESCRIPTOR = 0;
+	static const boost::uint16_t CALL_POSE = 1;
+	static const boost::uint16_t CALL_ANALOG = 2;
+	static const std::size_t CALL_POSE_VALUES = 7;
+
+	/// @brief Receives device calls: the calls the plugin makes, or those of a
+	/// replayed log.
+	class CallSink {
+	public:
+		virtual ~CallSink() {}
+		virtual void descriptor(std::size_t seat, const char *json, std::size_t length) = 0;
+		virtual void pose(std::size_t seat, boost::uint32_t sensor, const double *pose) = 0;
+		virtual void analog(std::size_t seat, const double *values, std::size_t count) = 0;
+	};
+
+	/// @brief Appends calls to a memory-mapped log file.
+	///
+	/// Each call is written straight from its arguments into the mapping:
+	/// no staging buffer, no system call, no allocation. When the mapping is
+	/// full the file is doubled and mapped again. Any thread may append; a
+	/// short lock keeps calls whole and in order.
+	class CallLogWriter : public CallSink, boost::noncopyable {
+	public:
+		typedef boost::chrono::steady_clock Clock;
+
+		explicit CallLogWriter(std::string const &path, std::size_t initialBytes = 16 << 20);
+		/// Cuts the file to the calls written.
+		~CallLogWriter();
+
+		bool isOpen() const { return m_region.get_address() != NULL; }
+
+		void descriptor(std::size_t seat, const char *json, std::size_t length);
+		void pose(std::size_t seat, boost::uint32_t sensor, const double *pose);
+		void analog(std::size_t seat, const double *values, std::size_t count);
+
+		/// Calls dropped because the file could not grow.
+		boost::uint64_t dropped() const { return m_dropped; }
+
+	private:
+		unsigned char *append(boost::uint16_t kind, std::size_t seat, std::size_t size);
+		void commit();
+		bool grow(std::size_t needed);
+
+		std::string m_path;
+		boost::mutex m_mutex;
+		Clock::time_point m_start;
+		boost::interprocess::mapped_region m_region;
+		std::size_t m_capacity;
+		std::size_t m_used;
+		boost::uint64_t m_dropped;
+	};
+
+	/// @brief One logged call; @c arguments points into the mapped log.
+	struct CallView {
+		boost::uint64_t timeNsec;
+		boost::uint16_t kind;
+		boost::uint16_t seat;
+		boost::uint32_t size;
+		const unsigned char *arguments;
+	};
+
+	/// @brief Reads a call log in place from a read-only mapping.
+	class CallLogReader : boost::noncopyable {
+	public:
+		explicit CallLogReader(std::string const &path);
+
+		bool isOpen() const { return m_end != 0; }
+
+		/// @brief The next call, false at the end of the log.
+		bool next(CallView &call);
+
+		/// @brief Whether the log ended on a call that does not fit in it.
+		bool truncated() const { return m_truncated; }
+
+	private:
+		boost::interprocess::mapped_region m_region;
+		const unsigned char *m_begin;
+		std::size_t m_end;
+		std::size_t m_offset;
+		bool m_truncated;
+	};
+
+	/// @brief Feed every call of @p log to @p sink, in order. False if the
+	/// log is cut short or holds a call that is not understood.
+	bool replayCalls(CallLogReader &log, CallSink &sink);
+
+	/// @brief Mock sink that folds every call (kind, seat and the bits of
+	/// its arguments, not its time) into one 64-bit FNV-1a digest: two logs
+	/// with equal digests made the same calls with bit-identical arguments.
+	class DigestSink : public CallSink {
+	public:
+		DigestSink();
+		void descriptor(std::size_t seat, const char *json, std::size_t length);
+		void pose(std::size_t seat, boost::uint32_t sensor, const double *pose);
+		void analog(std::size_t seat, const double *values, std::size_t count);
+
+		boost::uint64_t digest() const { return m_digest; }
+		boost::uint64_t descriptors() const { return m_descriptors; }
+		boost::uint64_t poses() const { return m_poses; }
+		boost::uint64_t analogs() const { return m_analogs; }
+
+	private:
+		void mix(const void *data, std::size_t size);
+
+		boost::uint64_t m_digest;
+		boost::uint64_t m_descriptors;
+		boost::uint64_t m_poses;
+		boost::uint64_t m_analogs;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformCallLog_h_GUID_74F5AA3D_2D46_468B_BBA3_292F2266AE86
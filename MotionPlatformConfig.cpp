@@ -0,0 +1,547 @@
+/** @file
+	@brief Implementation of the runtime configuration and descriptor builder.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformConfig.h"
+#include "MotionPlatformJson.h"
+#include "MotionPlatformReplay.h"
+#include "MotionPlatformScript.h"
+#include "MotionPlatformSimulation.h"
+
+// Generated from the plugin's JSON descriptor
+#include "com_vectionvr_osvr_motionPlatformDevicePlugin_json.h"
+
+// Library/third-party includes
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace motionplatform {
+
+	namespace {
+
+		/// largest whole number a double holds exactly
+		const double MAX_COUNT = 9007199254740992.0;
+
+		bool syntaxError(JsonReader const &json, std::string &error) {
+			error = json.where();
+			return false;
+		}
+
+		/*
+		 * The value just read is not what @p key takes
+		 */
+		bool typeError(JsonReader const &json, const char *key, std::string const &expected, std::string &error) {
+			if (json.error()) {
+				return syntaxError(json, error);
+			}
+			error = json.where() + ": " + key + " must be " + expected;
+			return false;
+		}
+
+		bool readNumber(JsonReader &json, const char *key, double &value, std::string &error) {
+			if (json.next() != JsonReader::JSON_NUMBER || !std::isfinite(json.number())) {
+				return typeError(json, key, "a finite number", error);
+			}
+			value = json.number();
+			return true;
+		}
+
+		bool readCount(JsonReader &json, const char *key, double max, std::size_t &value, std::string &error) {
+			if (json.next() != JsonReader::JSON_NUMBER || !(json.number() >= 0 && json.number() <= max) ||
+				std::floor(json.number()) != json.number()) {
+				return typeError(json, key, max < MAX_COUNT
+					? "a whole number up to " + boost::lexical_cast<std::string>(max) : "a whole number", error);
+			}
+			value = static_cast<std::size_t>(json.number());
+			return true;
+		}
+
+		bool readFlag(JsonReader &json, const char *key, bool &value, std::string &error) {
+			if (json.next() != JsonReader::JSON_BOOLEAN) {
+				return typeError(json, key, "true or false", error);
+			}
+			value = json.boolean();
+			return true;
+		}
+
+		bool readText(JsonReader &json, const char *key, std::string &value, std::string &error) {
+			if (json.next() != JsonReader::JSON_STRING) {
+				return typeError(json, key, "a string", error);
+			}
+			json.text(value);
+			return true;
+		}
+
+		/// ["<text>", ...]
+		bool readTextList(JsonReader &json, const char *key, std::vector<std::string> &values, std::string &error) {
+			if (json.next() != JsonReader::JSON_ARRAY_BEGIN) {
+				return typeError(json, key, "an array of strings", error);
+			}
+			values.clear();
+			for (JsonReader::Event event = json.next(); event != JsonReader::JSON_ARRAY_END; event = json.next()) {
+				if (event != JsonReader::JSON_STRING) {
+					return typeError(json, key, "an array of strings", error);
+				}
+				values.push_back(std::string());
+				json.text(values.back());
+			}
+			return true;
+		}
+
+		/// {"<name>": "<text>", ...}
+		bool readTextMap(JsonReader &json, const char *key, std::map<std::string, std::string> &values,
+			std::string &error) {
+			if (json.next() != JsonReader::JSON_OBJECT_BEGIN) {
+				return typeError(json, key, "an object of strings", error);
+			}
+			values.clear();
+			std::string name;
+			for (JsonReader::Event event = json.next(); event != JsonReader::JSON_OBJECT_END; event = json.next()) {
+				if (event != JsonReader::JSON_KEY) {
+					return syntaxError(json, error);
+				}
+				json.text(name);
+				if (json.next() != JsonReader::JSON_STRING) {
+					return typeError(json, key, "an object of strings", error);
+				}
+				json.text(values[name]);
+			}
+			return true;
+		}
+
+		/// {"<seat>": "<script>", ...}
+		bool readSeatScripts(JsonReader &json, std::map<std::size_t, std::string> &scripts, std::string &error) {
+			if (json.next() != JsonReader::JSON_OBJECT_BEGIN) {
+				return typeError(json, "scripts", "an object of strings", error);
+			}
+			scripts.clear();
+			std::string name;
+			for (JsonReader::Event event = json.next(); event != JsonReader::JSON_OBJECT_END; event = json.next()) {
+				if (event != JsonReader::JSON_KEY) {
+					return syntaxError(json, error);
+				}
+				json.text(name);
+				std::size_t seat;
+				try {
+					seat = boost::lexical_cast<std::size_t>(name);
+				} catch (boost::bad_lexical_cast const &) {
+					error = json.where() + ": scripts keys must be seat numbers";
+					return false;
+				}
+				if (json.next() != JsonReader::JSON_STRING) {
+					return typeError(json, "scripts", "an object of strings", error);
+				}
+				json.text(scripts[seat]);
+			}
+			return true;
+		}
+
+		/// {"file": "<path>" or "files": ["<path>", ...], "speed": 1, "seek": 0,
+		///  "loopBegin": 0, "loopEnd": 0, "readAhead": 4}
+		bool readReplay(JsonReader &json, Config &config, std::string &error) {
+			if (json.next() != JsonReader::JSON_OBJECT_BEGIN) {
+				return typeError(json, "replay", "an object", error);
+			}
+			bool file = false;
+			bool files = false;
+			for (JsonReader::Event event = json.next(); event != JsonReader::JSON_OBJECT_END; event = json.next()) {
+				if (event != JsonReader::JSON_KEY) {
+					return syntaxError(json, error);
+				}
+				bool read = true;
+				if (json.equals("file")) {
+					std::string path;
+					read = readText(json, "replay.file", path, error);
+					config.replay.clear();
+					if (!path.empty()) {
+						config.replay.push_back(path);
+					}
+					file = true;
+				} else if (json.equals("files")) {
+					read = readTextList(json, "replay.files", config.replay, error);
+					files = true;
+				} else if (json.equals("speed")) {
+					read = readNumber(json, "replay.speed", config.replaySpeed, error);
+				} else if (json.equals("seek")) {
+					read = readNumber(json, "replay.seek", config.replaySeek, error);
+				} else if (json.equals("loopBegin")) {
+					read = readNumber(json, "replay.loopBegin", config.replayLoopBegin, error);
+				} else if (json.equals("loopEnd")) {
+					read = readNumber(json, "replay.loopEnd", config.replayLoopEnd, error);
+				} else if (json.equals("readAhead")) {
+					read = readCount(json, "replay.readAhead", MAX_COUNT, config.replayReadAhead, error);
+				} else if (!json.skip()) {
+					return syntaxError(json, error);
+				}
+				if (!read) {
+					return false;
+				}
+			}
+			if (file && files) {
+				error = "replay: give file or files, not both";
+				return false;
+			}
+			return true;
+		}
+
+		/*
+		 * The params schema: every key the driver understands and the JSON
+		 * type of its value. Unknown keys are skipped whole.
+		 */
+		bool readParams(JsonReader &json, Config &config, std::string &error) {
+			if (json.next() != JsonReader::JSON_OBJECT_BEGIN) {
+				return typeError(json, "params", "an object", error);
+			}
+			for (JsonReader::Event event = json.next(); event != JsonReader::JSON_OBJECT_END; event = json.next()) {
+				if (event != JsonReader::JSON_KEY) {
+					return syntaxError(json, error);
+				}
+				bool read = true;
+				std::size_t count = 0;
+				if (json.equals("seats")) {
+					read = readCount(json, "seats", MAX_COUNT, config.seats, error);
+				} else if (json.equals("workers")) {
+					read = readCount(json, "workers", MAX_COUNT, config.workers, error);
+				} else if (json.equals("rate")) {
+					read = readNumber(json, "rate", config.rateHz, error);
+				} else if (json.equals("sequence")) {
+					read = readFlag(json, "sequence", config.sequence, error);
+				} else if (json.equals("metricsPort")) {
+					read = readCount(json, "metricsPort", 65535, count, error);
+					config.metricsPort = static_cast<unsigned short>(count);
+				} else if (json.equals("traceFile")) {
+					read = readText(json, "traceFile", config.traceFile, error);
+				} else if (json.equals("captureFile")) {
+					read = readText(json, "captureFile", config.captureFile, error);
+				} else if (json.equals("noise")) {
+					read = readText(json, "noise", config.noise, error);
+				} else if (json.equals("script")) {
+					read = readText(json, "script", config.script, error);
+				} else if (json.equals("scripts")) {
+					read = readSeatScripts(json, config.seatScripts, error);
+				} else if (json.equals("replay")) {
+					read = readReplay(json, config, error);
+				} else if (json.equals("signals")) {
+					read = readTextMap(json, "signals", config.channelSignals, error);
+				} else if (json.equals("vibration")) {
+					read = readTextList(json, "vibration", config.vibration, error);
+				} else if (json.equals("channels")) {
+					read = readTextMap(json, "channels", config.channelExpressions, error);
+				} else if (!json.skip()) {
+					return syntaxError(json, error);
+				}
+				if (!read) {
+					return false;
+				}
+			}
+			return json.next() == JsonReader::JSON_END || syntaxError(json, error);
+		}
+
+	} // namespace
+
+	Config::Config()
+		: seats(1), workers(1), rateHz(1.0), sequence(true), metricsPort(0),
+		replaySpeed(1.0), replaySeek(0), replayLoopBegin(0), replayLoopEnd(0), replayReadAhead(4) {}
+
+	bool loadConfig(std::string const &json, Config &config, std::string &error) {
+		Config result(config);
+		JsonReader reader(json.data(), json.size());
+		if (!readParams(reader, result, error)) {
+			return false;
+		}
+
+		if (result.seats < 1 || result.seats > 0xffff) {
+			error = "seats must be between 1 and 65535";
+			return false;
+		}
+		if (result.workers < 1 || result.workers > MAX_WORKERS) {
+			error = "workers must be between 1 and " + boost::lexical_cast<std::string>(MAX_WORKERS);
+			return false;
+		}
+		if (!(result.rateHz > 0 && result.rateHz <= 10000)) {
+			error = "rate must be above 0 and at most 10000 Hz";
+			return false;
+		}
+		if (!result.noise.empty()) {
+			NoiseGenerator noise(1, result.rateHz);
+			if (!noise.configure(result.noise, error)) {
+				error = "noise: " + error;
+				return false;
+			}
+		}
+		Script script;
+		if (!result.script.empty() && !parseScript(result.script, script, error)) {
+			error = "script: " + error;
+			return false;
+		}
+		/// seats usually share a few scripts; each text is checked once
+		std::set<std::string> checked;
+		checked.insert(result.script);
+		for (std::map<std::size_t, std::string>::const_iterator it = result.seatScripts.begin();
+			it != result.seatScripts.end(); ++it) {
+			if (it->first >= result.seats) {
+				error = "scripts: no seat " + boost::lexical_cast<std::string>(it->first);
+				return false;
+			}
+			if (!checked.insert(it->second).second) {
+				continue;
+			}
+			if (!it->second.empty() && !parseScript(it->second, script, error)) {
+				error = "scripts." + boost::lexical_cast<std::string>(it->first) + ": " + error;
+				return false;
+			}
+		}
+		if (!(result.replaySpeed >= 0 && result.replaySpeed <= 1000)) {
+			error = "replay.speed must be between 0 and 1000";
+			return false;
+		}
+		if (!(result.replaySeek >= 0 && result.replayLoopBegin >= 0 && result.replayLoopEnd >= 0)) {
+			error = "replay times must not be negative";
+			return false;
+		}
+		if (result.replayReadAhead > ReplayPlayer::MAX_READ_AHEAD) {
+			error = "replay.readAhead must be at most " + boost::lexical_cast<std::string>(ReplayPlayer::MAX_READ_AHEAD);
+			return false;
+		}
+		SignalGenerator signals;
+		if (!buildSignals(result, signals, error)) {
+			return false;
+		}
+		if (signals.maxFrequency() * 2 >= result.rateHz) {
+			error = "signals: frequencies must stay below half the tick rate";
+			return false;
+		}
+		VibrationBank vibration(1, result.rateHz);
+		if (!buildVibration(result, vibration, error)) {
+			return false;
+		}
+		ExpressionSet expressions;
+		if (!buildExpressions(result, expressions, error)) {
+			return false;
+		}
+		config = result;
+		return true;
+	}
+
+	bool buildSignals(Config const &config, SignalGenerator &signals, std::string &error) {
+		for (std::map<std::string, std::string>::const_iterator it = config.channelSignals.begin();
+			it != config.channelSignals.end(); ++it) {
+			int channel = channelIndex(it->first);
+			if (channel < 0) {
+				error = "signals: unknown channel " + it->first;
+				return false;
+			}
+			if (!signals.add(static_cast<std::size_t>(channel), it->second, error)) {
+				error = "signals." + it->first + ": " + error;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool buildVibration(Config const &config, VibrationBank &vibration, std::string &error) {
+		for (std::size_t i = 0; i < config.vibration.size(); ++i) {
+			if (!vibration.addVoice(config.vibration[i], error)) {
+				error = "vibration." + boost::lexical_cast<std::string>(i) + ": " + error;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool buildExpressions(Config const &config, ExpressionSet &expressions, std::string &error) {
+		for (std::map<std::string, std::string>::const_iterator it = config.channelExpressions.begin();
+			it != config.channelExpressions.end(); ++it) {
+			int channel = channelIndex(it->first);
+			if (channel < 0) {
+				error = "channels: unknown channel " + it->first;
+				return false;
+			}
+			if (!expressions.add(static_cast<std::size_t>(channel), it->second, error)) {
+				error = "channels." + it->first + ": " + error;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::string const &seatScript(Config const &config, std::size_t seat) {
+		std::map<std::size_t, std::string>::const_iterator it = config.seatScripts.find(seat);
+		return it != config.seatScripts.end() ? it->second : config.script;
+	}
+
+	namespace {
+
+		const std::size_t NOWHERE = std::string::npos;
+
+		/// @brief The descriptor embedded from
+		/// com_vectionvr_osvr_motionPlatformDevicePlugin.json, and where the
+		/// parts that depend on the config lie in its text. The build checks
+		/// the file declares them (see MotionPlatformLayout.cmake); a part
+		/// that is missing anyway is left as the file has it.
+		struct DescriptorTemplate {
+			DescriptorTemplate();
+
+			std::string text;
+			/// the closing quote of deviceName
+			std::size_t nameEnd;
+			/// interfaces.analog.count
+			std::size_t countBegin;
+			std::size_t countEnd;
+			std::size_t count;
+			/// the last interfaces.analog.traits entry, from the end of the one
+			/// before it, so its comma goes with it
+			std::size_t lastTraitBegin;
+			std::size_t lastTraitEnd;
+			/// semantics.sample_sequence, likewise from the end of the member
+			/// before it (so it must not be the first member)
+			std::size_t sequenceBegin;
+			std::size_t sequenceEnd;
+		};
+
+		DescriptorTemplate::DescriptorTemplate()
+			: text(com_vectionvr_osvr_motionPlatformDevicePlugin_json,
+				sizeof(com_vectionvr_osvr_motionPlatformDevicePlugin_json) - 1),
+			nameEnd(NOWHERE), countBegin(NOWHERE), countEnd(NOWHERE), count(0),
+			lastTraitBegin(NOWHERE), lastTraitEnd(NOWHERE), sequenceBegin(NOWHERE), sequenceEnd(NOWHERE) {
+			JsonReader json(text.data(), text.size());
+			/// member names down to the open container, "" for array entries
+			std::vector<std::string> names;
+			/// end of the previous entry in each open container
+			std::vector<std::size_t> previous;
+			std::string key;
+			for (;;) {
+				const JsonReader::Event event = json.next();
+				if (event == JsonReader::JSON_END || event == JsonReader::JSON_ERROR) {
+					return;
+				}
+				if (event == JsonReader::JSON_KEY) {
+					json.text(key);
+					continue;
+				}
+				if (event == JsonReader::JSON_OBJECT_BEGIN || event == JsonReader::JSON_ARRAY_BEGIN) {
+					names.push_back(key);
+					previous.push_back(json.end());
+					key.clear();
+					continue;
+				}
+				if (event == JsonReader::JSON_OBJECT_END || event == JsonReader::JSON_ARRAY_END) {
+					key = names.back();
+					names.pop_back();
+					previous.pop_back();
+					if (names.empty()) {
+						continue;
+					}
+				}
+				/// an entry of the innermost open container is complete
+				std::string parent;
+				for (std::size_t i = 1; i < names.size(); ++i) {
+					parent += (i > 1 ? "." : "") + names[i];
+				}
+				if (parent.empty() && key == "deviceName" && event == JsonReader::JSON_STRING) {
+					nameEnd = json.end() - 1;
+				} else if (parent == "interfaces.analog" && key == "count" && event == JsonReader::JSON_NUMBER) {
+					countBegin = json.begin();
+					countEnd = json.end();
+					count = static_cast<std::size_t>(json.number());
+				} else if (parent == "interfaces.analog.traits") {
+					lastTraitBegin = previous.back();
+					lastTraitEnd = json.end();
+				} else if (parent == "semantics" && key == "sample_sequence" && text[previous.back() - 1] != '{') {
+					sequenceBegin = previous.back();
+					sequenceEnd = json.end();
+				}
+				previous.back() = json.end();
+			}
+		}
+
+		/// @brief Replace [begin, end) of a text with @p replacement
+		struct Edit {
+			Edit(std::size_t begin_, std::size_t end_, std::string const &replacement_)
+				: begin(begin_), end(end_), replacement(replacement_) {}
+			bool operator<(Edit const &other) const { return begin > other.begin; }
+			std::size_t begin;
+			std::size_t end;
+			std::string replacement;
+		};
+
+	} // namespace
+
+	/*
+	 * The embedded descriptor with the seat number in its name and, without
+	 * the sequence channel, its last analog channel left out
+	 */
+	std::string buildDescriptor(Config const &config, std::size_t seat) {
+		static const DescriptorTemplate descriptor;
+		std::vector<Edit> edits;
+		if (seat > 0 && descriptor.nameEnd != NOWHERE) {
+			edits.push_back(Edit(descriptor.nameEnd, descriptor.nameEnd,
+				" (seat " + boost::lexical_cast<std::string>(seat) + ")"));
+		}
+		if (!config.sequence) {
+			if (descriptor.countBegin != NOWHERE && descriptor.count > 0) {
+				edits.push_back(Edit(descriptor.countBegin, descriptor.countEnd,
+					boost::lexical_cast<std::string>(descriptor.count - 1)));
+			}
+			if (descriptor.lastTraitBegin != NOWHERE) {
+				edits.push_back(Edit(descriptor.lastTraitBegin, descriptor.lastTraitEnd, std::string()));
+			}
+			if (descriptor.sequenceBegin != NOWHERE) {
+				edits.push_back(Edit(descriptor.sequenceBegin, descriptor.sequenceEnd, std::string()));
+			}
+		}
+		/// back to front, so each edit leaves the offsets before it valid
+		std::sort(edits.begin(), edits.end());
+		std::string result(descriptor.text);
+		for (std::size_t i = 0; i < edits.size(); ++i) {
+			result.replace(edits[i].begin, edits[i].end - edits[i].begin, edits[i].replacement);
+		}
+		return result;
+	}
+
+	ConfigStore::ConfigStore(Config const &initial)
+		: m_config(boost::make_shared<Config>(initial)), m_generation(0) {}
+
+	ConfigStore::ConfigPtr ConfigStore::get() const {
+		boost::mutex::scoped_lock lock(m_mutex);
+		return m_config;
+	}
+
+	void ConfigStore::set(Config const &config) {
+		ConfigPtr next = boost::make_shared<Config>(config);
+		{
+			boost::mutex::scoped_lock lock(m_mutex);
+			m_config = next;
+		}
+		m_generation.fetch_add(1, boost::memory_order_release);
+	}
+
+} // namespace motionplatform
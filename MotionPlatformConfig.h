@@ -0,0 +1,156 @@
+/** @file
+	@brief Runtime configuration of the motion platform and the JSON
+	descriptor derived from it.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformConfig_h_GUID_A63D1E27_5F8C_4B90_82D4_C1E7B3A9F056
+#define INCLUDED_MotionPlatformConfig_h_GUID_A63D1E27_5F8C_4B90_82D4_C1E7B3A9F056
+
+// Internal Includes
+#include "MotionPlatformExpression.h"
+#include "MotionPlatformNoise.h"
+#include "MotionPlatformSignal.h"
+#include "MotionPlatformVibration.h"
+
+// Library/third-party includes
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// Most scheduler workers a config may ask for; each is a thread.
+	const std::size_t MAX_WORKERS = 64;
+
+	/// @brief Everything that can be set from the server configuration.
+	///
+	/// seats and workers only take effect when the devices are created; the
+	/// other fields can change while running.
+	struct Config {
+		Config();
+
+		std::size_t seats;
+		std::size_t workers;
+		double rateHz;
+		/// publish the sample_sequence channel
+		bool sequence;
+		/// localhost port of the metrics exporter, 0 to disable
+		unsigned short metricsPort;
+		/// Chrome trace output file, empty to disable
+		std::string traceFile;
+		/// device call log (see CallLogWriter), empty to disable
+		std::string captureFile;
+		/// colored noise for the target angles (see NoiseGenerator), empty for
+		/// uniform random angles
+		std::string noise;
+		/// motion script every seat plays (see parseScript), empty for
+		/// random motion
+		std::string script;
+		/// per-seat scripts, overriding @c script
+		std::map<std::size_t, std::string> seatScripts;
+		/// recordings the seats replay, merged by timestamp (see
+		/// ReplayPlayer), empty for none
+		std::vector<std::string> replay;
+		/// replay rate relative to the recording, 0 to pause
+		double replaySpeed;
+		/// replay position in seconds; changing it seeks
+		double replaySeek;
+		/// replay loop region in seconds, off unless the end is after the
+		/// beginning
+		double replayLoopBegin;
+		double replayLoopEnd;
+		/// replay blocks decoded ahead of the playhead on a thread of its
+		/// own, 0 to read each block when it is reached
+		std::size_t replayReadAhead;
+		/// test signals played on actuator channels, by channel name (see
+		/// SignalGenerator)
+		std::map<std::string, std::string> channelSignals;
+		/// expressions replacing actuator channels, by channel name (see
+		/// ExpressionSet)
+		std::map<std::string, std::string> channelExpressions;
+		/// vibration voices mixed on top of the actuator channels (see
+		/// VibrationBank)
+		std::vector<std::string> vibration;
+	};
+
+	/// @brief Read the driver "params" object (JSON) over the values already in
+	/// @p config. Each known key must hold the JSON type it takes; unknown
+	/// keys are ignored. Scripts are checked here so a bad one rejects the
+	/// whole config.
+	/// @return false, with @p error set and @p config untouched, if @p json is
+	/// not valid.
+	bool loadConfig(std::string const &json, Config &config, std::string &error);
+
+	/// @brief Build the OSVR JSON device descriptor for @p seat as @p config
+	/// currently describes it.
+	std::string buildDescriptor(Config const &config, std::size_t seat);
+
+	/// @brief Script text @p seat plays under @p config, empty for none.
+	std::string const &seatScript(Config const &config, std::size_t seat);
+
+	/// @brief Set up the test signals of @p config in @p signals.
+	/// @return false, with @p error set, if one is invalid.
+	bool buildSignals(Config const &config, SignalGenerator &signals, std::string &error);
+
+	/// @brief Add the vibration voices of @p config to @p vibration.
+	/// @return false, with @p error set, if one is invalid.
+	bool buildVibration(Config const &config, VibrationBank &vibration, std::string &error);
+
+	/// @brief Compile the channel expressions of @p config into @p expressions.
+	/// @return false, with @p error set, if one is invalid.
+	bool buildExpressions(Config const &config, ExpressionSet &expressions, std::string &error);
+
+	/// @brief The live configuration, shared by all seats.
+	///
+	/// Readers poll generation() (a single atomic load) every tick and only
+	/// take the lock to fetch a new snapshot when it has changed.
+	class ConfigStore : boost::noncopyable {
+	public:
+		typedef boost::shared_ptr<const Config> ConfigPtr;
+
+		explicit ConfigStore(Config const &initial);
+
+		ConfigPtr get() const;
+		void set(Config const &config);
+
+		boost::uint64_t generation() const { return m_generation.load(boost::memory_order_acquire); }
+
+	private:
+		mutable boost::mutex m_mutex;
+		ConfigPtr m_config;
+		boost::atomic<boost::uint64_t> m_generation;
+	};
+
+	typedef boost::shared_ptr<ConfigStore> ConfigStorePtr;
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformConfig_h_GUID_A63D1E27_5F8C_4B90_82D4_C1E7B3A9F056
@@ -0,0 +1,254 @@
+/** @file
+	@brief Companion client that subscribes to the motion platform's semantic
+	paths and reports loss, reordering and latency of the received reports.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/ClientKit/Context.h>
+#include <osvr/ClientKit/Interface.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+	struct Options {
+		Options()
+			: device("/com_vectionvr_osvr_motionPlatformDevicePlugin/SyncMotionPlatformDevice"),
+			rateHz(1), seconds(10), pollUsec(100) {}
+		std::string device;
+		double rateHz; ///< rate the plugin is expected to publish at
+		double seconds;
+		unsigned pollUsec;
+	};
+
+	/// @brief Arrival bookkeeping for one subscribed path.
+	class StreamStats {
+	public:
+		StreamStats(std::string const &path, double periodSeconds)
+			: m_path(path), m_period(periodSeconds), m_hasLast(false),
+			m_received(0), m_reordered(0), m_duplicates(0), m_missing(0),
+			m_hasSequence(false), m_lastSequence(0), m_sequenceDropped(0),
+			m_sequenceReordered(0), m_sequenceRepeated(0) {}
+
+		std::string const &path() const { return m_path; }
+
+		/*
+		 * Check the report timestamp against the previous one and record the
+		 * report's age on arrival
+		 */
+		void onReport(const OSVR_TimeValue *timestamp) {
+			OSVR_TimeValue now;
+			osvrTimeValueGetNow(&now);
+			++m_received;
+			m_latencyUsec.push_back(osvrTimeValueDurationSeconds(&now, timestamp) * 1.0e6);
+			if (m_hasLast) {
+				double dt = osvrTimeValueDurationSeconds(timestamp, &m_last);
+				if (dt < 0) {
+					++m_reordered;
+					return;
+				}
+				if (dt == 0) {
+					++m_duplicates;
+				} else if (dt > 1.5 * m_period) {
+					// a late report spanning several periods stands in for the ones lost
+					m_missing += static_cast<boost::uint64_t>(dt / m_period + 0.5) - 1;
+				}
+			}
+			m_last = *timestamp;
+			m_hasLast = true;
+		}
+
+		/*
+		 * Check a sample sequence number against the previous one
+		 */
+		void onSequence(double value) {
+			boost::uint64_t sequence = static_cast<boost::uint64_t>(value);
+			if (m_hasSequence) {
+				if (sequence == m_lastSequence) {
+					++m_sequenceRepeated;
+					return;
+				}
+				if (sequence < m_lastSequence) {
+					++m_sequenceReordered;
+					return;
+				}
+				m_sequenceDropped += sequence - m_lastSequence - 1;
+			}
+			m_lastSequence = sequence;
+			m_hasSequence = true;
+		}
+
+		void report(std::ostream &os) {
+			os << m_path << "\n  received " << m_received
+				<< ", missing " << m_missing;
+			if (m_received + m_missing > 0) {
+				os << " (" << 100.0 * m_missing / (m_received + m_missing) << "% loss)";
+			}
+			os << ", reordered " << m_reordered << ", duplicate timestamps " << m_duplicates << "\n";
+			if (m_hasSequence) {
+				os << "  sequence: dropped " << m_sequenceDropped;
+				if (m_received + m_sequenceDropped > 0) {
+					os << " (" << 100.0 * m_sequenceDropped / (m_received + m_sequenceDropped) << "% drop rate)";
+				}
+				os << ", reordered " << m_sequenceReordered << ", repeated " << m_sequenceRepeated << "\n";
+			}
+			if (!m_latencyUsec.empty()) {
+				std::sort(m_latencyUsec.begin(), m_latencyUsec.end());
+				double mean = 0;
+				for (std::size_t i = 0; i < m_latencyUsec.size(); ++i) {
+					mean += m_latencyUsec[i];
+				}
+				mean /= m_latencyUsec.size();
+				os << "  latency (us): mean " << mean
+					<< " p50 " << at(0.50) << " p99 " << at(0.99)
+					<< " max " << m_latencyUsec.back() << "\n";
+			}
+		}
+
+	private:
+		double at(double p) const {
+			return m_latencyUsec[static_cast<std::size_t>(p * (m_latencyUsec.size() - 1))];
+		}
+
+		std::string m_path;
+		double m_period;
+		bool m_hasLast;
+		OSVR_TimeValue m_last;
+		boost::uint64_t m_received;
+		boost::uint64_t m_reordered;
+		boost::uint64_t m_duplicates;
+		boost::uint64_t m_missing;
+		std::vector<double> m_latencyUsec;
+		bool m_hasSequence;
+		boost::uint64_t m_lastSequence;
+		boost::uint64_t m_sequenceDropped;
+		boost::uint64_t m_sequenceReordered;
+		boost::uint64_t m_sequenceRepeated;
+	};
+
+	void orientationCallback(void *userdata, const OSVR_TimeValue *timestamp,
+		const OSVR_OrientationReport * /*report*/) {
+		static_cast<StreamStats *>(userdata)->onReport(timestamp);
+	}
+
+	void analogCallback(void *userdata, const OSVR_TimeValue *timestamp,
+		const OSVR_AnalogReport * /*report*/) {
+		static_cast<StreamStats *>(userdata)->onReport(timestamp);
+	}
+
+	void sequenceCallback(void *userdata, const OSVR_TimeValue *timestamp,
+		const OSVR_AnalogReport *report) {
+		StreamStats *stats = static_cast<StreamStats *>(userdata);
+		stats->onReport(timestamp);
+		stats->onSequence(report->state);
+	}
+
+	bool parseOptions(int argc, char *argv[], Options &opts) {
+		try {
+			for (int i = 1; i + 1 < argc; i += 2) {
+				std::string arg(argv[i]);
+				std::string value(argv[i + 1]);
+				if (arg == "--device") {
+					opts.device = value;
+				} else if (arg == "--rate") {
+					opts.rateHz = boost::lexical_cast<double>(value);
+				} else if (arg == "--seconds") {
+					opts.seconds = boost::lexical_cast<double>(value);
+				} else if (arg == "--poll-us") {
+					opts.pollUsec = boost::lexical_cast<unsigned>(value);
+				} else {
+					return false;
+				}
+			}
+		} catch (boost::bad_lexical_cast const &) {
+			return false;
+		}
+		return argc % 2 == 1 && opts.rateHz > 0;
+	}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		std::cerr << "Usage: MotionPlatformConsumer [--device PATH] [--rate HZ] "
+			"[--seconds S] [--poll-us US]" << std::endl;
+		return 1;
+	}
+
+	osvr::clientkit::ClientContext context("com.vectionvr.osvr.MotionPlatformConsumer");
+
+	/// semantic paths declared in com_vectionvr_osvr_motionPlatformDevicePlugin.json
+	const std::string semantic = opts.device + "/semantic/";
+	const char *analogPaths[] = {
+		"target_displacement/x", "target_displacement/y", "target_displacement/z",
+		"target_angle/x", "target_angle/y", "target_angle/z"
+	};
+	const double period = 1.0 / opts.rateHz;
+
+	StreamStats orientation(semantic + "current_orientation", period);
+	context.getInterface(orientation.path()).registerCallback(&orientationCallback, &orientation);
+	std::vector<StreamStats> analogs;
+	analogs.reserve(6);
+	for (int i = 0; i < 6; ++i) {
+		analogs.push_back(StreamStats(semantic + analogPaths[i], period));
+	}
+	for (std::size_t i = 0; i < analogs.size(); ++i) {
+		context.getInterface(analogs[i].path()).registerCallback(&analogCallback, &analogs[i]);
+	}
+	/// the sequence channel identifies individual samples
+	StreamStats sequence(semantic + "sample_sequence", period);
+	context.getInterface(sequence.path()).registerCallback(&sequenceCallback, &sequence);
+
+	std::cout << "MPS_CONSUMER > Listening for " << opts.seconds << " s" << std::endl;
+	OSVR_TimeValue start;
+	osvrTimeValueGetNow(&start);
+	for (;;) {
+		context.update();
+		OSVR_TimeValue now;
+		osvrTimeValueGetNow(&now);
+		if (osvrTimeValueDurationSeconds(&now, &start) >= opts.seconds) {
+			break;
+		}
+		if (opts.pollUsec) {
+			boost::this_thread::sleep(boost::posix_time::microseconds(opts.pollUsec));
+		}
+	}
+
+	orientation.report(std::cout);
+	for (std::size_t i = 0; i < analogs.size(); ++i) {
+		analogs[i].report(std::cout);
+	}
+	sequence.report(std::cout);
+	return 0;
+}
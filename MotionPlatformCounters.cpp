@@ -0,0 +1,106 @@
+/** @file
+	@brief Implementation of the thread CPU cost counters.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformCounters.h"
+
+// Library/third-party includes
+#include <boost/chrono.hpp>
+#include <boost/chrono/thread_clock.hpp>
+
+// Standard includes
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace motionplatform {
+
+	namespace {
+
+#if defined(__linux__)
+		/*
+		 * User-space count of @p config for the calling thread on any CPU,
+		 * or -1 if it cannot be opened
+		 */
+		int openCounter(boost::uint64_t config) {
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = config;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+		}
+
+		boost::uint64_t readCounter(int fd) {
+			boost::uint64_t value = 0;
+			if (fd < 0 || ::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+				return 0;
+			}
+			return value;
+		}
+#endif
+
+	} // namespace
+
+#if defined(__linux__)
+	ThreadCounters::ThreadCounters()
+		: m_instructions(openCounter(PERF_COUNT_HW_INSTRUCTIONS)), m_cycles(openCounter(PERF_COUNT_HW_CPU_CYCLES)) {}
+
+	ThreadCounters::~ThreadCounters() {
+		if (m_instructions >= 0) {
+			close(m_instructions);
+		}
+		if (m_cycles >= 0) {
+			close(m_cycles);
+		}
+	}
+#else
+	ThreadCounters::ThreadCounters() : m_instructions(-1), m_cycles(-1) {}
+
+	ThreadCounters::~ThreadCounters() {}
+#endif
+
+	void ThreadCounters::read(Reading &reading) const {
+#if defined(BOOST_CHRONO_HAS_THREAD_CLOCK)
+		reading.cpuNsec = static_cast<boost::uint64_t>(boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+			boost::chrono::thread_clock::now().time_since_epoch()).count());
+#else
+		reading.cpuNsec = 0;
+#endif
+#if defined(__linux__)
+		reading.instructions = readCounter(m_instructions);
+		reading.cycles = readCounter(m_cycles);
+#else
+		reading.instructions = 0;
+		reading.cycles = 0;
+#endif
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,75 @@
+/** @file
+	@brief CPU cost counters for the calling thread: CPU time, and retired
+	instructions and cycles where the hardware counters can be opened.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformCounters_h_GUID_96DC64D4_F0D1_4077_BE76_0267A5A91317
+#define INCLUDED_MotionPlatformCounters_h_GUID_96DC64D4_F0D1_4077_BE76_0267A5A91317
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+// - none
+
+namespace motionplatform {
+
+	/// @brief Counts what the thread that created it spends.
+	///
+	/// CPU time is always available. Instructions and cycles come from
+	/// perf_event_open on Linux, counted in user space only; they stay zero
+	/// where the kernel refuses (e.g. perf_event_paranoid, containers) or on
+	/// other systems, and hardware() says which. Instructions barely move
+	/// between runs, so they make a tighter budget than time.
+	///
+	/// Other threads are not counted: measure a one-worker scheduler, which
+	/// runs every seat on the calling thread.
+	class ThreadCounters : boost::noncopyable {
+	public:
+		struct Reading {
+			boost::uint64_t cpuNsec;
+			boost::uint64_t instructions;
+			boost::uint64_t cycles;
+		};
+
+		ThreadCounters();
+		~ThreadCounters();
+
+		/// @brief Whether instructions and cycles are counted.
+		bool hardware() const { return m_instructions >= 0 && m_cycles >= 0; }
+
+		/// @brief Totals so far; take the difference of two readings.
+		void read(Reading &reading) const;
+
+	private:
+		int m_instructions;
+		int m_cycles;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformCounters_h_GUID_96DC64D4_F0D1_4077_BE76_0267A5A91317
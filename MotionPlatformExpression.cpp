@@ -0,0 +1,525 @@
+/** @file
+	@brief Implementation of the channel expression compiler and evaluator.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformExpression.h"
+#include "MotionPlatformNumber.h"
+#include "MotionPlatformSimulation.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <sstream>
+
+namespace motionplatform {
+
+	const std::size_t ExpressionSet::BLOCK_SIZE;
+	const std::size_t ExpressionSet::MAX_REGISTERS;
+
+	int channelIndex(std::string const &name) {
+		static const char *const groups[2] = { "target_displacement.", "target_angle." };
+		static const std::size_t firstChannel[2] = { 0, Simulation::TARGET_ANGLE_CHANNEL };
+		for (int g = 0; g < 2; ++g) {
+			std::string prefix(groups[g]);
+			if (name.size() == prefix.size() + 1 && name.compare(0, prefix.size(), prefix) == 0) {
+				char axis = name[prefix.size()];
+				if (axis >= 'x' && axis <= 'z') {
+					return static_cast<int>(firstChannel[g] + (axis - 'x'));
+				}
+			}
+		}
+		return -1;
+	}
+
+	/// @brief Recursive descent parser emitting register code as it goes.
+	///
+	/// Values stay compile-time constants until they meet a register operand,
+	/// so constant subexpressions never reach the program. Registers are used
+	/// as a stack: an operation's operands are always the topmost live
+	/// registers, and its result takes the lower of the two.
+	class ExpressionSet::Compiler {
+	public:
+		static const std::size_t MAX_DEPTH = 64;
+
+		Compiler(std::vector<Instruction> &program, std::size_t firstRegister)
+			: m_program(program), m_next(firstRegister), m_pos(0), m_depth(0) {}
+
+		bool compile(std::string const &source, boost::uint8_t &result, std::string &error) {
+			m_source = source;
+			m_pos = 0;
+			m_depth = 0;
+			m_error.clear();
+			Value value;
+			if (!expression(value)) {
+				error = m_error;
+				return false;
+			}
+			skipSpace();
+			if (m_pos != m_source.size()) {
+				error = fail("unexpected '" + m_source.substr(m_pos, 1) + "'");
+				return false;
+			}
+			if (!materialize(value)) {
+				error = m_error;
+				return false;
+			}
+			result = value.reg;
+			return true;
+		}
+
+	private:
+		struct Value {
+			Value() : constant(true), number(0), reg(0) {}
+			bool constant;
+			double number;
+			boost::uint8_t reg;
+		};
+
+		std::string fail(std::string const &what) {
+			if (m_error.empty()) {
+				std::ostringstream os;
+				os << "column " << m_pos + 1 << ": " << what;
+				m_error = os.str();
+			}
+			return m_error;
+		}
+
+		void skipSpace() {
+			while (m_pos < m_source.size() && std::isspace(static_cast<unsigned char>(m_source[m_pos]))) {
+				++m_pos;
+			}
+		}
+
+		bool accept(char c) {
+			skipSpace();
+			if (m_pos < m_source.size() && m_source[m_pos] == c) {
+				++m_pos;
+				return true;
+			}
+			return false;
+		}
+
+		bool allocate(boost::uint8_t &reg) {
+			if (m_next >= MAX_REGISTERS) {
+				fail("expression too deep");
+				return false;
+			}
+			reg = static_cast<boost::uint8_t>(m_next++);
+			return true;
+		}
+
+		void emit(Opcode op, boost::uint8_t dst, boost::uint8_t a = 0, boost::uint8_t b = 0, double immediate = 0) {
+			Instruction instruction = { static_cast<boost::uint8_t>(op), dst, a, b, immediate };
+			m_program.push_back(instruction);
+		}
+
+		bool materialize(Value &value) {
+			if (!value.constant) {
+				return true;
+			}
+			if (!allocate(value.reg)) {
+				return false;
+			}
+			emit(OP_CONST, value.reg, 0, 0, value.number);
+			value.constant = false;
+			return true;
+		}
+
+		static double fold(Opcode op, double a, double b) {
+			switch (op) {
+			case OP_ADD: return a + b;
+			case OP_SUB: return a - b;
+			case OP_MUL: return a * b;
+			case OP_DIV: return a / b;
+			case OP_MIN: return std::min(a, b);
+			case OP_MAX: return std::max(a, b);
+			case OP_NEG: return -a;
+			case OP_SIN: return std::sin(a);
+			case OP_COS: return std::cos(a);
+			case OP_ABS: return std::fabs(a);
+			case OP_SQRT: return std::sqrt(a);
+			default: return 0;
+			}
+		}
+
+		bool unary(Opcode op, Value &value) {
+			if (value.constant) {
+				value.number = fold(op, value.number, 0);
+				return true;
+			}
+			emit(op, value.reg, value.reg);
+			return true;
+		}
+
+		bool binary(Opcode op, Value &left, Value &right) {
+			if (left.constant && right.constant) {
+				left.number = fold(op, left.number, right.number);
+				return true;
+			}
+			if (!materialize(left) || !materialize(right)) {
+				return false;
+			}
+			boost::uint8_t dst = std::min(left.reg, right.reg);
+			emit(op, dst, left.reg, right.reg);
+			m_next = dst + 1u;
+			left.reg = dst;
+			return true;
+		}
+
+		bool expression(Value &value) {
+			if (!term(value)) {
+				return false;
+			}
+			for (;;) {
+				Opcode op;
+				if (accept('+')) {
+					op = OP_ADD;
+				} else if (accept('-')) {
+					op = OP_SUB;
+				} else {
+					return true;
+				}
+				Value right;
+				if (!term(right) || !binary(op, value, right)) {
+					return false;
+				}
+			}
+		}
+
+		bool term(Value &value) {
+			if (!factor(value)) {
+				return false;
+			}
+			for (;;) {
+				Opcode op;
+				if (accept('*')) {
+					op = OP_MUL;
+				} else if (accept('/')) {
+					op = OP_DIV;
+				} else {
+					return true;
+				}
+				Value right;
+				if (!factor(right) || !binary(op, value, right)) {
+					return false;
+				}
+			}
+		}
+
+		/*
+		 * Every level of nesting (parentheses, calls, unary minus) passes
+		 * through here, so this bounds the parser's recursion
+		 */
+		bool factor(Value &value) {
+			if (m_depth >= MAX_DEPTH) {
+				fail("nested too deeply");
+				return false;
+			}
+			++m_depth;
+			const bool parsed = primary(value);
+			--m_depth;
+			return parsed;
+		}
+
+		bool primary(Value &value) {
+			if (accept('-')) {
+				return factor(value) && unary(OP_NEG, value);
+			}
+			if (accept('(')) {
+				if (!expression(value)) {
+					return false;
+				}
+				if (!accept(')')) {
+					fail("expected ')'");
+					return false;
+				}
+				return true;
+			}
+			skipSpace();
+			if (m_pos >= m_source.size()) {
+				fail("unexpected end of expression");
+				return false;
+			}
+			const char *start = m_source.c_str() + m_pos;
+			if (std::isdigit(static_cast<unsigned char>(*start)) || *start == '.') {
+				return number(value);
+			}
+			std::size_t nameEnd = m_pos;
+			while (nameEnd < m_source.size() && (std::isalnum(static_cast<unsigned char>(m_source[nameEnd])) ||
+				m_source[nameEnd] == '_' || m_source[nameEnd] == '.')) {
+				++nameEnd;
+			}
+			if (nameEnd == m_pos) {
+				fail("unexpected '" + m_source.substr(m_pos, 1) + "'");
+				return false;
+			}
+			std::string name = m_source.substr(m_pos, nameEnd - m_pos);
+			m_pos = nameEnd;
+			if (accept('(')) {
+				return call(name, value);
+			}
+			return variable(name, value);
+		}
+
+		/*
+		 * Digits with an optional '.' and exponent, read with '.' as the
+		 * decimal point whatever the locale; hex, inf and nan are not numbers
+		 */
+		bool number(Value &value) {
+			const std::size_t begin = m_pos;
+			std::size_t digits = 0;
+			while (m_pos < m_source.size() && std::isdigit(static_cast<unsigned char>(m_source[m_pos]))) {
+				++m_pos;
+				++digits;
+			}
+			if (m_pos < m_source.size() && m_source[m_pos] == '.') {
+				++m_pos;
+				while (m_pos < m_source.size() && std::isdigit(static_cast<unsigned char>(m_source[m_pos]))) {
+					++m_pos;
+					++digits;
+				}
+			}
+			if (digits != 0 && m_pos < m_source.size() && (m_source[m_pos] == 'e' || m_source[m_pos] == 'E')) {
+				++m_pos;
+				if (m_pos < m_source.size() && (m_source[m_pos] == '+' || m_source[m_pos] == '-')) {
+					++m_pos;
+				}
+				if (m_pos >= m_source.size() || !std::isdigit(static_cast<unsigned char>(m_source[m_pos]))) {
+					fail("invalid number");
+					return false;
+				}
+				while (m_pos < m_source.size() && std::isdigit(static_cast<unsigned char>(m_source[m_pos]))) {
+					++m_pos;
+				}
+			}
+			if (digits == 0 || (m_pos < m_source.size() && (std::isalnum(static_cast<unsigned char>(m_source[m_pos])) ||
+				m_source[m_pos] == '_' || m_source[m_pos] == '.'))) {
+				m_pos = begin;
+				fail("invalid number");
+				return false;
+			}
+			const char *text = m_source.c_str();
+			if (!parseDecimal(text + begin, text + m_pos, value.number)) {
+				m_pos = begin;
+				fail("number out of range");
+				return false;
+			}
+			return true;
+		}
+
+		bool variable(std::string const &name, Value &value) {
+			if (name == "pi") {
+				value.number = boost::math::constants::pi<double>();
+				return true;
+			}
+			if (name == "e") {
+				value.number = boost::math::constants::e<double>();
+				return true;
+			}
+			Opcode op;
+			int channel = channelIndex(name);
+			if (name == "t") {
+				op = OP_TIME;
+			} else if (name == "seat") {
+				op = OP_SEAT;
+			} else if (channel >= 0) {
+				op = OP_CHANNEL;
+			} else {
+				fail("unknown name '" + name + "'");
+				return false;
+			}
+			if (!allocate(value.reg)) {
+				return false;
+			}
+			value.constant = false;
+			emit(op, value.reg, 0, 0, static_cast<double>(channel));
+			return true;
+		}
+
+		bool call(std::string const &name, Value &value) {
+			static const char *const unaryNames[4] = { "sin", "cos", "abs", "sqrt" };
+			static const Opcode unaryOps[4] = { OP_SIN, OP_COS, OP_ABS, OP_SQRT };
+			for (int i = 0; i < 4; ++i) {
+				if (name == unaryNames[i]) {
+					if (!expression(value) || !closeCall()) {
+						return false;
+					}
+					return unary(unaryOps[i], value);
+				}
+			}
+			if (name == "min" || name == "max") {
+				Value right;
+				if (!expression(value)) {
+					return false;
+				}
+				if (!accept(',')) {
+					fail("expected ','");
+					return false;
+				}
+				if (!expression(right) || !closeCall()) {
+					return false;
+				}
+				return binary(name == "min" ? OP_MIN : OP_MAX, value, right);
+			}
+			fail("unknown function '" + name + "'");
+			return false;
+		}
+
+		bool closeCall() {
+			if (!accept(')')) {
+				fail("expected ')'");
+				return false;
+			}
+			return true;
+		}
+
+		std::vector<Instruction> &m_program;
+		std::size_t m_next;
+		std::string m_source;
+		std::size_t m_pos;
+		std::size_t m_depth;
+		std::string m_error;
+	};
+
+	ExpressionSet::ExpressionSet() {}
+
+	bool ExpressionSet::add(std::size_t channel, std::string const &expression, std::string &error) {
+		if (channel >= Simulation::ACTUATOR_COUNT) {
+			error = "no such channel";
+			return false;
+		}
+		std::vector<Output> outputs;
+		for (std::size_t i = 0; i < m_outputs.size(); ++i) {
+			if (m_outputs[i].channel != channel) {
+				outputs.push_back(m_outputs[i]);
+			}
+		}
+		Output output = { channel, expression };
+		outputs.push_back(output);
+		return compile(outputs, error);
+	}
+
+	/*
+	 * Rebuild the whole program; each output's result stays pinned in its
+	 * register so every channel is read before any is written
+	 */
+	bool ExpressionSet::compile(std::vector<Output> const &outputs, std::string &error) {
+		std::vector<Instruction> program;
+		std::vector<boost::uint8_t> results;
+		for (std::size_t i = 0; i < outputs.size(); ++i) {
+			Compiler compiler(program, results.empty() ? 0 : results.back() + 1u);
+			boost::uint8_t result = 0;
+			if (!compiler.compile(outputs[i].source, result, error)) {
+				return false;
+			}
+			results.push_back(result);
+		}
+		m_outputs = outputs;
+		m_program.swap(program);
+		m_results.swap(results);
+		return true;
+	}
+
+	void ExpressionSet::evaluate(std::size_t begin, std::size_t end, double time,
+		float *actuators, std::size_t seatCount) const {
+		if (m_outputs.empty()) {
+			return;
+		}
+		double regs[MAX_REGISTERS][BLOCK_SIZE];
+		const Instruction *program = &m_program[0];
+		const std::size_t length = m_program.size();
+		for (std::size_t block = begin; block < end; block += BLOCK_SIZE) {
+			const std::size_t n = std::min(BLOCK_SIZE, end - block);
+			for (std::size_t pc = 0; pc < length; ++pc) {
+				const Instruction &in = program[pc];
+				double *d = regs[in.dst];
+				const double *a = regs[in.a];
+				const double *b = regs[in.b];
+				switch (in.op) {
+				case OP_CONST:
+					std::fill(d, d + n, in.immediate);
+					break;
+				case OP_TIME:
+					std::fill(d, d + n, time);
+					break;
+				case OP_SEAT:
+					for (std::size_t l = 0; l < n; ++l) {
+						d[l] = static_cast<double>(block + l);
+					}
+					break;
+				case OP_CHANNEL:
+					std::copy(actuators + static_cast<std::size_t>(in.immediate) * seatCount + block,
+						actuators + static_cast<std::size_t>(in.immediate) * seatCount + block + n, d);
+					break;
+				case OP_ADD:
+					for (std::size_t l = 0; l < n; ++l) d[l] = a[l] + b[l];
+					break;
+				case OP_SUB:
+					for (std::size_t l = 0; l < n; ++l) d[l] = a[l] - b[l];
+					break;
+				case OP_MUL:
+					for (std::size_t l = 0; l < n; ++l) d[l] = a[l] * b[l];
+					break;
+				case OP_DIV:
+					for (std::size_t l = 0; l < n; ++l) d[l] = a[l] / b[l];
+					break;
+				case OP_MIN:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::min(a[l], b[l]);
+					break;
+				case OP_MAX:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::max(a[l], b[l]);
+					break;
+				case OP_NEG:
+					for (std::size_t l = 0; l < n; ++l) d[l] = -a[l];
+					break;
+				case OP_SIN:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::sin(a[l]);
+					break;
+				case OP_COS:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::cos(a[l]);
+					break;
+				case OP_ABS:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::fabs(a[l]);
+					break;
+				case OP_SQRT:
+					for (std::size_t l = 0; l < n; ++l) d[l] = std::sqrt(a[l]);
+					break;
+				}
+			}
+			for (std::size_t i = 0; i < m_outputs.size(); ++i) {
+				const double *r = regs[m_results[i]];
+				float *out = actuators + m_outputs[i].channel * seatCount + block;
+				for (std::size_t l = 0; l < n; ++l) {
+					// also maps NaN (e.g. sqrt of a negative) to -1
+					out[l] = static_cast<float>(r[l] > -1.0 ? std::min(r[l], 1.0) : -1.0);
+				}
+			}
+		}
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,115 @@
+/** @file
+	@brief Channel expressions compiled once to a flat register bytecode and
+	evaluated for a block of seats at a time.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformExpression_h_GUID_8C2F4A61_D93B_4E7A_A5C0_19E6F7B3D482
+#define INCLUDED_MotionPlatformExpression_h_GUID_8C2F4A61_D93B_4E7A_A5C0_19E6F7B3D482
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief Actuator channel called @p name ("target_displacement.x" ...
+	/// "target_angle.z"), or -1.
+	int channelIndex(std::string const &name);
+
+	/// @brief Expressions that replace actuator channels.
+	///
+	/// An expression is built from numbers, + - * / (and unary -), parentheses,
+	/// the functions sin, cos, abs, sqrt, min and max, and the names
+	///  - t: simulated time in seconds,
+	///  - seat: the seat index,
+	///  - pi and e,
+	///  - any actuator channel, e.g. target_angle.x, as the simulation
+	///    produced it this tick (before any expression is applied).
+	///
+	/// All expressions of the set are compiled into one register program,
+	/// with constant subexpressions folded. Each instruction is then run over
+	/// a block of seats before the next, so dispatch is paid once per block
+	/// and the per-instruction loops vectorize. Registers are double, since a
+	/// float t would step by milliseconds after a few hours and phases such
+	/// as sin(2*pi*50*t) would fall apart. Results are clamped to [-1, 1].
+	class ExpressionSet : boost::noncopyable {
+	public:
+		/// Seats evaluated per instruction
+		static const std::size_t BLOCK_SIZE = 32;
+		static const std::size_t MAX_REGISTERS = 32;
+
+		ExpressionSet();
+
+		/// @brief Compile @p expression to drive @p channel, replacing any
+		/// expression it had.
+		/// @return false, with @p error set and the set unchanged, if the
+		/// expression is invalid.
+		bool add(std::size_t channel, std::string const &expression, std::string &error);
+
+		bool empty() const { return m_outputs.empty(); }
+
+		/// @brief Evaluate every expression for seats [begin, end) at @p time
+		/// and store the results in the channel-major @p actuators array.
+		/// Disjoint ranges may be evaluated concurrently.
+		void evaluate(std::size_t begin, std::size_t end, double time,
+			float *actuators, std::size_t seatCount) const;
+
+	private:
+		enum Opcode {
+			OP_CONST, OP_TIME, OP_SEAT, OP_CHANNEL,
+			OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MIN, OP_MAX,
+			OP_NEG, OP_SIN, OP_COS, OP_ABS, OP_SQRT
+		};
+		struct Instruction {
+			boost::uint8_t op;
+			boost::uint8_t dst;
+			boost::uint8_t a;
+			boost::uint8_t b;
+			/// OP_CONST value, OP_CHANNEL index
+			double immediate;
+		};
+		struct Output {
+			std::size_t channel;
+			std::string source;
+		};
+		class Compiler;
+
+		bool compile(std::vector<Output> const &outputs, std::string &error);
+
+		std::vector<Output> m_outputs;
+		std::vector<Instruction> m_program;
+		/// register holding the result of m_outputs[i]
+		std::vector<boost::uint8_t> m_results;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformExpression_h_GUID_8C2F4A61_D93B_4E7A_A5C0_19E6F7B3D482
@@ -0,0 +1,83 @@
+/** @file
+	@brief 64-bit seek and tell on C stdio files.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformFile_h_GUID_1887E57D_6636_4C9B_9B23_632B3D551664
+#define INCLUDED_MotionPlatformFile_h_GUID_1887E57D_6636_4C9B_9B23_632B3D551664
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <limits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#endif
+
+namespace motionplatform {
+
+#if defined(_WIN32)
+	typedef __int64 FileOffset;
+#elif defined(__unix__) || defined(__APPLE__)
+	typedef off_t FileOffset;
+#else
+	typedef long FileOffset;
+#endif
+
+	/// @brief fseek with 64-bit offsets, also where long is 32 bits
+	/// (_fseeki64 on Windows, fseeko elsewhere; 32-bit POSIX builds need
+	/// _FILE_OFFSET_BITS=64, which the build sets). An offset the platform
+	/// cannot seek to fails rather than wrapping.
+	inline bool seekFile(std::FILE *file, boost::int64_t offset, int whence) {
+		if (offset > static_cast<boost::int64_t>(std::numeric_limits<FileOffset>::max()) ||
+			offset < static_cast<boost::int64_t>(std::numeric_limits<FileOffset>::min())) {
+			return false;
+		}
+#if defined(_WIN32)
+		return _fseeki64(file, static_cast<FileOffset>(offset), whence) == 0;
+#elif defined(__unix__) || defined(__APPLE__)
+		return fseeko(file, static_cast<FileOffset>(offset), whence) == 0;
+#else
+		return std::fseek(file, static_cast<FileOffset>(offset), whence) == 0;
+#endif
+	}
+
+	/// @brief ftell with 64-bit offsets; negative on error.
+	inline boost::int64_t tellFile(std::FILE *file) {
+#if defined(_WIN32)
+		return _ftelli64(file);
+#elif defined(__unix__) || defined(__APPLE__)
+		return ftello(file);
+#else
+		return std::ftell(file);
+#endif
+	}
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformFile_h_GUID_1887E57D_6636_4C9B_9B23_632B3D551664
@@ -0,0 +1,574 @@
+/** @file
+	@brief Mutation fuzzer for the parsers that read outside input: the
+	config loader, the descriptor built from what it accepts, device call
+	logs and replayed recordings.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// property_tree's JSON parser still includes the deprecated <boost/bind.hpp>
+#define BOOST_BIND_GLOBAL_PLACEHOLDERS
+
+// Internal Includes
+#include "MotionPlatformCallLog.h"
+#include "MotionPlatformConfig.h"
+#include "MotionPlatformRecording.h"
+#include "MotionPlatformReplay.h"
+#include "MotionPlatformSimulation.h"
+
+// Library/third-party includes
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__)
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+	typedef boost::chrono::steady_clock Clock;
+	typedef std::vector<unsigned char> Input;
+
+	enum Target { TARGET_CONFIG, TARGET_DESCRIPTOR, TARGET_CALLS, TARGET_REPLAY, TARGET_COUNT };
+	const char *const TARGET_NAMES[TARGET_COUNT] = { "config", "descriptor", "calls", "replay" };
+
+	/// what LLVMFuzzerTestOneInput feeds its input to
+	Target g_target = TARGET_CONFIG;
+	/// the binary formats are decoded from a file, as the plugin reads them
+	std::string g_scratch = "MotionPlatformFuzzer.scratch";
+
+	bool parseTarget(std::string const &name, Target &target) {
+		for (int t = 0; t < TARGET_COUNT; ++t) {
+			if (name == TARGET_NAMES[t]) {
+				target = static_cast<Target>(t);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool writeScratch(const unsigned char *data, std::size_t size) {
+		std::FILE *file = std::fopen(g_scratch.c_str(), "wb");
+		if (!file) {
+			return false;
+		}
+		const bool written = size == 0 || std::fwrite(data, 1, size, file) == size;
+		return std::fclose(file) == 0 && written;
+	}
+
+	bool readFile(std::string const &path, Input &data) {
+		data.clear();
+		std::FILE *file = std::fopen(path.c_str(), "rb");
+		if (!file) {
+			return false;
+		}
+		unsigned char buffer[4096];
+		std::size_t n;
+		while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+			data.insert(data.end(), buffer, buffer + n);
+		}
+		std::fclose(file);
+		return true;
+	}
+
+	/*
+	 * Stop like a crash would, so both drivers report the input: a property
+	 * of the output was broken without anything faulting
+	 */
+	void violated(const char *what) {
+		std::cerr << "MPS_FUZZ > " << what << std::endl;
+		std::abort();
+	}
+
+	bool fuzzConfig(const unsigned char *data, std::size_t size) {
+		motionplatform::Config config;
+		std::string error;
+		return motionplatform::loadConfig(std::string(reinterpret_cast<const char *>(data), size), config, error);
+	}
+
+	/*
+	 * Whatever config is accepted, the descriptor built from it must parse
+	 * and declare the channels the device publishes
+	 */
+	bool fuzzDescriptor(const unsigned char *data, std::size_t size) {
+		namespace pt = boost::property_tree;
+		motionplatform::Config config;
+		std::string error;
+		if (!motionplatform::loadConfig(std::string(reinterpret_cast<const char *>(data), size), config, error)) {
+			return false;
+		}
+		const std::size_t analogCount = motionplatform::Simulation::ACTUATOR_COUNT + (config.sequence ? 1 : 0);
+		const std::size_t seats[2] = { 0, config.seats - 1 };
+		for (std::size_t i = 0; i < 2; ++i) {
+			pt::ptree tree;
+			try {
+				std::istringstream is(motionplatform::buildDescriptor(config, seats[i]));
+				pt::read_json(is, tree);
+			} catch (pt::json_parser_error const &) {
+				violated("descriptor is not valid JSON");
+			}
+			if (tree.get<std::size_t>("interfaces.analog.count", 0) != analogCount ||
+				tree.get_child("interfaces.analog.traits", pt::ptree()).size() != analogCount ||
+				static_cast<bool>(tree.get_child_optional("semantics.sample_sequence")) != config.sequence) {
+				violated("descriptor does not match the published channels");
+			}
+		}
+		return true;
+	}
+
+	bool fuzzCalls(const unsigned char *data, std::size_t size) {
+		if (!writeScratch(data, size)) {
+			return false;
+		}
+		motionplatform::CallLogReader log(g_scratch);
+		if (!log.isOpen()) {
+			return false;
+		}
+		motionplatform::DigestSink digest;
+		return motionplatform::replayCalls(log, digest);
+	}
+
+	/*
+	 * Replay onto more seats than the seed recording has, through a seek
+	 * and a loop, as the plugin's replay phase would
+	 */
+	bool fuzzReplay(const unsigned char *data, std::size_t size) {
+		if (!writeScratch(data, size)) {
+			return false;
+		}
+		const std::size_t seats = 4;
+		motionplatform::ReplayPlayer player(std::vector<std::string>(1, g_scratch), seats);
+		if (!player.isOpen()) {
+			return false;
+		}
+		const double duration = player.duration();
+		player.seek(duration * 0.25);
+		player.setLoop(duration * 0.5, duration * 0.75);
+		player.setSpeed(3);
+		float pitch[seats], yaw[seats], roll[seats];
+		float actuators[motionplatform::Simulation::ACTUATOR_COUNT * seats];
+		for (int tick = 0; tick < 64; ++tick) {
+			player.writeTargets(0, seats, pitch, yaw, roll);
+			player.writeActuators(0, seats, actuators, seats);
+			player.advance(0.01);
+		}
+		return true;
+	}
+
+	/// @brief Feed one input to the current target.
+	/// @return whether the input was accepted as valid.
+	bool runInput(const unsigned char *data, std::size_t size) {
+		switch (g_target) {
+		case TARGET_CONFIG:
+			return fuzzConfig(data, size);
+		case TARGET_DESCRIPTOR:
+			return fuzzDescriptor(data, size);
+		case TARGET_CALLS:
+			return fuzzCalls(data, size);
+		case TARGET_REPLAY:
+			return fuzzReplay(data, size);
+		default:
+			return false;
+		}
+	}
+
+	/*
+	 * Starting inputs: configs that reach every key, and a call log and a
+	 * recording written by the same writers the tools use
+	 */
+	std::vector<Input> seedInputs() {
+		std::vector<Input> seeds;
+		if (g_target == TARGET_CONFIG || g_target == TARGET_DESCRIPTOR) {
+			const char *const configs[] = {
+				"{}",
+				"{\"seats\": 4, \"workers\": 2, \"rate\": 250, \"sequence\": false, \"metricsPort\": 0}",
+				"{\"seats\": 3, \"script\": \"ramp pitch 10 2; hold 1; oscillate roll 5 1 4; loop\","
+				" \"scripts\": {\"1\": \"hold 2\", \"2\": \"\"}, \"noise\": \"pink 2\"}",
+				"{\"replay\": {\"files\": [\"a.rec\", \"b.rec\"], \"speed\": 1.5, \"seek\": 2,"
+				" \"loopBegin\": 1, \"loopEnd\": 4, \"readAhead\": 8}}",
+				"{\"rate\": 1000, \"signals\": {\"target_angle.x\": \"chirp 0.1 20 60 0.5\"},"
+				" \"vibration\": [\"target_displacement.z sine 35 0.05\"],"
+				" \"channels\": {\"target_displacement.z\": \"0.3*sin(2*pi*t) + -(seat/4)\"}}",
+			};
+			for (std::size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); ++i) {
+				seeds.push_back(Input(configs[i], configs[i] + std::strlen(configs[i])));
+			}
+		} else if (g_target == TARGET_CALLS) {
+			{
+				motionplatform::CallLogWriter log(g_scratch, 4096);
+				motionplatform::Config config;
+				config.seats = 2;
+				const double pose[motionplatform::CALL_POSE_VALUES] = { 0, 0, 0, 1, 0, 0, 0 };
+				const double values[3] = { 0.5, -0.25, 7 };
+				for (std::size_t seat = 0; seat < config.seats; ++seat) {
+					const std::string descriptor = motionplatform::buildDescriptor(config, seat);
+					log.descriptor(seat, descriptor.data(), descriptor.size());
+					log.pose(seat, 0, pose);
+					log.analog(seat, values, 3);
+				}
+			}
+			seeds.push_back(Input());
+			readFile(g_scratch, seeds.back());
+		} else {
+			{
+				motionplatform::Simulation sim(2);
+				motionplatform::RecordingWriter writer(g_scratch, 2, 1000, 32);
+				std::vector<motionplatform::SampleRecord> samples;
+				for (boost::uint64_t tick = 0; tick < 200; ++tick) {
+					sim.step(0.001);
+					motionplatform::captureTick(sim, tick * 1000, samples);
+					writer.appendTick(samples);
+				}
+			}
+			seeds.push_back(Input());
+			readFile(g_scratch, seeds.back());
+		}
+		return seeds;
+	}
+
+	/// bytes the text formats are built from, spliced in by the mutator
+	const char *const TOKENS[] = {
+		"{", "}", "[", "]", "\"", ":", ",", "\\u0000", "\\", "true", "false", "null", "0", "-1", "1e309",
+		"65535", "65536", "4294967296", "\"seats\"", "\"rate\"", "\"replay\"", "\"files\"", "\"scripts\"",
+		"\"signals\"", "\"channels\"", "\"vibration\"", "(", ")", "-", "*", "/", "sin(", "loop", ";"
+	};
+
+	/// little-endian integers that sit on the edges of the binary headers
+	const boost::uint64_t EDGES[] = { 0, 1, 0x7f, 0x80, 0xff, 0xffff, 0x7fffffff, 0xffffffff, 0xffffffffffffffffULL };
+
+	class Mutator {
+	public:
+		Mutator(boost::uint32_t seed, std::size_t maxLength) : m_rng(seed), m_maxLength(maxLength) {}
+
+		std::size_t below(std::size_t n) {
+			return n ? boost::random::uniform_int_distribution<std::size_t>(0, n - 1)(m_rng) : 0;
+		}
+
+		/// a few random edits of @p data, some of them taken from @p corpus
+		void mutate(Input &data, std::vector<Input> const &corpus, bool text) {
+			const std::size_t edits = 1 + below(4);
+			for (std::size_t e = 0; e < edits; ++e) {
+				const std::size_t at = below(data.size() + 1);
+				switch (below(7)) {
+				case 0:
+					if (at < data.size()) {
+						data[at] ^= static_cast<unsigned char>(1u << below(8));
+					}
+					break;
+				case 1:
+					if (at < data.size()) {
+						data[at] = static_cast<unsigned char>(below(256));
+					}
+					break;
+				case 2:
+					if (text) {
+						const char *token = TOKENS[below(sizeof(TOKENS) / sizeof(TOKENS[0]))];
+						data.insert(data.begin() + at, token, token + std::strlen(token));
+					} else {
+						data.insert(data.begin() + at, 1 + below(8), static_cast<unsigned char>(below(256)));
+					}
+					break;
+				case 3:
+					if (at < data.size()) {
+						data.erase(data.begin() + at, data.begin() + at + 1 + below(std::min<std::size_t>(data.size() - at, 64)));
+					}
+					break;
+				case 4:
+					if (at < data.size()) {
+						/// copy a range elsewhere, repeating structure
+						const std::size_t length = 1 + below(std::min<std::size_t>(data.size() - at, 256));
+						const Input range(data.begin() + at, data.begin() + at + length);
+						const std::size_t to = below(data.size() + 1);
+						data.insert(data.begin() + to, range.begin(), range.end());
+					}
+					break;
+				case 5:
+					if (at + 4 <= data.size()) {
+						/// aligned, so counts and offsets are hit
+						const std::size_t width = (at + 8 <= data.size() && below(2)) ? 8 : 4;
+						const std::size_t aligned = at & ~(width - 1);
+						const boost::uint64_t value = EDGES[below(sizeof(EDGES) / sizeof(EDGES[0]))];
+						std::memcpy(&data[aligned], &value, width);
+					}
+					break;
+				default: {
+					Input const &other = corpus[below(corpus.size())];
+					if (!other.empty()) {
+						const std::size_t from = below(other.size());
+						const std::size_t length = 1 + below(other.size() - from);
+						data.insert(data.begin() + at, other.begin() + from, other.begin() + from + length);
+					}
+					break;
+				}
+				}
+			}
+			if (data.size() > m_maxLength) {
+				data.resize(m_maxLength);
+			}
+		}
+
+	private:
+		boost::random::mt19937 m_rng;
+		std::size_t m_maxLength;
+	};
+
+#if defined(__unix__)
+	/// the input being run, written out if it crashes
+	const Input *volatile g_current = NULL;
+	char g_crashPath[256];
+
+	/*
+	 * Only async-signal-safe calls: save the input, then die of the same
+	 * signal
+	 */
+	extern "C" void onCrash(int signal) {
+		if (const Input *input = g_current) {
+			int fd = open(g_crashPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+			if (fd >= 0) {
+				if (!input->empty() && write(fd, &(*input)[0], input->size()) < 0) {
+					/* nothing more can be done here */
+				}
+				close(fd);
+			}
+		}
+		std::signal(signal, SIG_DFL);
+		raise(signal);
+	}
+
+	/*
+	 * On a stack of its own, so a stack overflow is reported too
+	 */
+	void installCrashHandler(Target target) {
+		std::snprintf(g_crashPath, sizeof(g_crashPath), "crash-%s", TARGET_NAMES[target]);
+		static std::vector<char> altStack(1 << 16);
+		stack_t stack;
+		std::memset(&stack, 0, sizeof(stack));
+		stack.ss_sp = &altStack[0];
+		stack.ss_size = altStack.size();
+		sigaltstack(&stack, NULL);
+		struct sigaction action;
+		std::memset(&action, 0, sizeof(action));
+		action.sa_handler = onCrash;
+		action.sa_flags = SA_ONSTACK;
+		sigemptyset(&action.sa_mask);
+		const int signals[4] = { SIGSEGV, SIGBUS, SIGFPE, SIGABRT };
+		for (int i = 0; i < 4; ++i) {
+			sigaction(signals[i], &action, NULL);
+		}
+	}
+#endif
+
+	struct Options {
+		Options() : target(TARGET_CONFIG), runs(100000), seed(5489u), maxLength(1 << 16), slowMs(25) {}
+		Target target;
+		boost::uint64_t runs;
+		boost::uint32_t seed;
+		std::size_t maxLength;
+		double slowMs;
+		std::vector<std::string> inputs;
+	};
+
+	void printUsage() {
+		std::cerr << "Usage: MotionPlatformFuzzer --target NAME [options] [INPUT...]\n"
+			"  --target NAME    config, descriptor, calls or replay\n"
+			"  --runs N         mutated inputs to run (default 100000)\n"
+			"  --seed N         mutation seed (default 5489)\n"
+			"  --max-len N      longest input in bytes (default 65536)\n"
+			"  --slow-ms MS     fail on an input that takes longer (default 25)\n"
+			"  --scratch PATH   file the binary inputs are decoded from\n"
+			"                   (default MotionPlatformFuzzer.scratch)\n"
+			"  INPUT            files run as they are before mutating starts, and\n"
+			"                   added to the seeds; pass a saved crash-* or slow-*\n"
+			"                   file with --runs 0 to reproduce it\n";
+	}
+
+	bool parseOptions(int argc, char *argv[], Options &opts) {
+		bool hasTarget = false;
+		try {
+			for (int i = 1; i < argc; ++i) {
+				std::string arg(argv[i]);
+				if (arg.compare(0, 2, "--") != 0) {
+					opts.inputs.push_back(arg);
+					continue;
+				}
+				if (i + 1 >= argc) {
+					return false;
+				}
+				std::string value(argv[++i]);
+				if (arg == "--target") {
+					hasTarget = parseTarget(value, opts.target);
+				} else if (arg == "--runs") {
+					opts.runs = boost::lexical_cast<boost::uint64_t>(value);
+				} else if (arg == "--seed") {
+					opts.seed = boost::lexical_cast<boost::uint32_t>(value);
+				} else if (arg == "--max-len") {
+					opts.maxLength = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--slow-ms") {
+					opts.slowMs = boost::lexical_cast<double>(value);
+				} else if (arg == "--scratch") {
+					g_scratch = value;
+				} else {
+					return false;
+				}
+			}
+		} catch (boost::bad_lexical_cast const &) {
+			return false;
+		}
+		return hasTarget && opts.maxLength > 0;
+	}
+
+	/*
+	 * Time one input; a slow one is saved and fails the run
+	 */
+	bool timeInput(Input const &input, Options const &opts, double &usec, bool &accepted) {
+#if defined(__unix__)
+		g_current = &input;
+#endif
+		const Clock::time_point start = Clock::now();
+		accepted = runInput(input.empty() ? NULL : &input[0], input.size());
+		usec = boost::chrono::duration<double, boost::micro>(Clock::now() - start).count();
+#if defined(__unix__)
+		g_current = NULL;
+#endif
+		if (usec > opts.slowMs * 1000) {
+			const std::string path = std::string("slow-") + TARGET_NAMES[opts.target];
+			std::FILE *file = std::fopen(path.c_str(), "wb");
+			if (file) {
+				if (!input.empty()) {
+					std::fwrite(&input[0], 1, input.size(), file);
+				}
+				std::fclose(file);
+			}
+			std::cerr << "MPS_FUZZ > FAIL: a " << input.size() << " byte input took " << usec / 1000
+				<< " ms, saved to " << path << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	/*
+	 * Run the given inputs, then opts.runs mutations of the corpus; inputs
+	 * the target accepts join the corpus, so mutations build on valid
+	 * structure
+	 */
+	int run(Options const &opts) {
+		g_target = opts.target;
+#if defined(__unix__)
+		installCrashHandler(opts.target);
+#endif
+		std::vector<Input> corpus = seedInputs();
+		double usec = 0;
+		bool accepted = false;
+		for (std::size_t i = 0; i < opts.inputs.size(); ++i) {
+			Input input;
+			if (!readFile(opts.inputs[i], input)) {
+				std::cerr << "MPS_FUZZ > Could not read " << opts.inputs[i] << std::endl;
+				return 1;
+			}
+			if (!timeInput(input, opts, usec, accepted)) {
+				return 1;
+			}
+			std::cerr << "MPS_FUZZ > " << opts.inputs[i] << ": " << (accepted ? "accepted" : "rejected") << " in "
+				<< usec << " us" << std::endl;
+			corpus.push_back(input);
+		}
+		const std::size_t seedCount = corpus.size();
+		const std::size_t maxCorpus = 512;
+		const bool text = opts.target == TARGET_CONFIG || opts.target == TARGET_DESCRIPTOR;
+		Mutator mutator(opts.seed, opts.maxLength);
+		boost::uint64_t acceptedCount = 0;
+		double totalBytes = 0;
+		double slowestUsec = 0;
+		const Clock::time_point start = Clock::now();
+		for (boost::uint64_t r = 0; r < opts.runs; ++r) {
+			Input input = corpus[mutator.below(corpus.size())];
+			mutator.mutate(input, corpus, text);
+			if (!timeInput(input, opts, usec, accepted)) {
+				return 1;
+			}
+			totalBytes += input.size();
+			slowestUsec = std::max(slowestUsec, usec);
+			if (accepted) {
+				++acceptedCount;
+				if (corpus.size() < maxCorpus) {
+					corpus.push_back(input);
+				} else {
+					corpus[seedCount + mutator.below(maxCorpus - seedCount)].swap(input);
+				}
+			}
+		}
+		const double elapsed = boost::chrono::duration<double>(Clock::now() - start).count();
+		if (opts.runs > 0) {
+			std::cerr << "MPS_FUZZ > " << TARGET_NAMES[opts.target] << ": " << opts.runs << " inputs in " << elapsed
+				<< " s, " << opts.runs / elapsed << " inputs/s, " << totalBytes / elapsed / 1.0e6 << " MB/s, "
+				<< acceptedCount << " accepted, slowest " << slowestUsec << " us" << std::endl;
+		}
+		std::remove(g_scratch.c_str());
+		return 0;
+	}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const boost::uint8_t *data, std::size_t size) {
+	runInput(data, size);
+	return 0;
+}
+
+#if defined(MOTIONPLATFORM_LIBFUZZER)
+/// libFuzzer drives the target named by MPS_FUZZ_TARGET
+extern "C" int LLVMFuzzerInitialize(int *, char ***) {
+	const char *target = std::getenv("MPS_FUZZ_TARGET");
+	if (!target || !parseTarget(target, g_target)) {
+		std::cerr << "MPS_FUZZ > Set MPS_FUZZ_TARGET to config, descriptor, calls or replay" << std::endl;
+		std::exit(1);
+	}
+	if (const char *scratch = std::getenv("MPS_FUZZ_SCRATCH")) {
+		g_scratch = scratch;
+	}
+	return 0;
+}
+#else
+int main(int argc, char *argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		printUsage();
+		return 1;
+	}
+	return run(opts);
+}
+#endif
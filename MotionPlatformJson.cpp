@@ -0,0 +1,438 @@
+/** @file
+	@brief Implementation of the JSON pull reader.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformJson.h"
+#include "MotionPlatformNumber.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+#include <sstream>
+
+namespace motionplatform {
+
+	const std::size_t JsonReader::MAX_DEPTH;
+
+	namespace {
+
+		inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+		int hexValue(char c) {
+			if (c >= '0' && c <= '9') {
+				return c - '0';
+			}
+			if (c >= 'a' && c <= 'f') {
+				return c - 'a' + 10;
+			}
+			if (c >= 'A' && c <= 'F') {
+				return c - 'A' + 10;
+			}
+			return -1;
+		}
+
+		/// the four hex digits at @p p, or -1
+		long hex4(const char *p) {
+			long value = 0;
+			for (int i = 0; i < 4; ++i) {
+				const int digit = hexValue(p[i]);
+				if (digit < 0) {
+					return -1;
+				}
+				value = value * 16 + digit;
+			}
+			return value;
+		}
+
+		/*
+		 * Decode the character at @p p of a string that scanString accepted
+		 * into @p out as UTF-8; returns the text consumed and sets @p length
+		 * to the bytes written
+		 */
+		std::size_t decode(const char *p, char out[4], std::size_t &length) {
+			if (*p != '\\') {
+				out[0] = *p;
+				length = 1;
+				return 1;
+			}
+			length = 1;
+			switch (p[1]) {
+			case 'b':
+				out[0] = '\b';
+				return 2;
+			case 'f':
+				out[0] = '\f';
+				return 2;
+			case 'n':
+				out[0] = '\n';
+				return 2;
+			case 'r':
+				out[0] = '\r';
+				return 2;
+			case 't':
+				out[0] = '\t';
+				return 2;
+			case 'u':
+				break;
+			default:
+				/// quote, backslash and slash stand for themselves
+				out[0] = p[1];
+				return 2;
+			}
+			unsigned long code = static_cast<unsigned long>(hex4(p + 2));
+			std::size_t consumed = 6;
+			if (code >= 0xD800 && code <= 0xDBFF) {
+				/// scanString checked that the low half follows
+				code = 0x10000 + ((code - 0xD800) << 10) + (static_cast<unsigned long>(hex4(p + 8)) - 0xDC00);
+				consumed = 12;
+			}
+			if (code < 0x80) {
+				out[0] = static_cast<char>(code);
+			} else if (code < 0x800) {
+				out[0] = static_cast<char>(0xC0 | (code >> 6));
+				out[1] = static_cast<char>(0x80 | (code & 0x3F));
+				length = 2;
+			} else if (code < 0x10000) {
+				out[0] = static_cast<char>(0xE0 | (code >> 12));
+				out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				out[2] = static_cast<char>(0x80 | (code & 0x3F));
+				length = 3;
+			} else {
+				out[0] = static_cast<char>(0xF0 | (code >> 18));
+				out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+				out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				out[3] = static_cast<char>(0x80 | (code & 0x3F));
+				length = 4;
+			}
+			return consumed;
+		}
+
+	} // namespace
+
+	JsonReader::JsonReader(const char *text, std::size_t length)
+		: m_text(text), m_length(length), m_pos(0), m_state(STATE_VALUE), m_depth(0), m_event(JSON_NULL),
+		m_start(0), m_stringBegin(0), m_stringEnd(0), m_escaped(false), m_number(0), m_boolean(false),
+		m_error(NULL) {}
+
+	JsonReader::Event JsonReader::next() {
+		if (m_event == JSON_ERROR || m_event == JSON_END) {
+			return m_event;
+		}
+		for (;;) {
+			while (m_pos < m_length && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+				m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+				++m_pos;
+			}
+			m_start = m_pos;
+			if (m_state == STATE_AFTER_VALUE && m_depth == 0) {
+				return m_pos == m_length ? (m_event = JSON_END) : fail("text after the document");
+			}
+			if (m_pos == m_length) {
+				return fail("unexpected end of text");
+			}
+			const char c = m_text[m_pos];
+			switch (m_state) {
+			case STATE_AFTER_VALUE:
+				if (c == ',') {
+					++m_pos;
+					m_state = m_stack[m_depth - 1] == '{' ? STATE_KEY : STATE_VALUE;
+					continue;
+				}
+				return close(c);
+			case STATE_FIRST_KEY:
+				if (c == '}') {
+					return close(c);
+				}
+				/* fall through */
+			case STATE_KEY:
+				if (c != '"') {
+					return fail("expected a member name");
+				}
+				if (!scanString()) {
+					return m_event;
+				}
+				while (m_pos < m_length && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+					m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+					++m_pos;
+				}
+				if (m_pos == m_length || m_text[m_pos] != ':') {
+					return fail("expected ':'");
+				}
+				++m_pos;
+				m_state = STATE_VALUE;
+				return m_event = JSON_KEY;
+			case STATE_FIRST_VALUE:
+				if (c == ']') {
+					return close(c);
+				}
+				/* fall through */
+			case STATE_VALUE:
+				return value();
+			}
+		}
+	}
+
+	bool JsonReader::skip() {
+		const std::size_t depth = m_depth;
+		do {
+			const Event event = next();
+			if (event == JSON_ERROR || event == JSON_END) {
+				return false;
+			}
+		} while (m_depth > depth);
+		return true;
+	}
+
+	bool JsonReader::equals(const char *text) const {
+		if (!m_escaped) {
+			const std::size_t length = m_stringEnd - m_stringBegin;
+			return std::strncmp(m_text + m_stringBegin, text, length) == 0 && text[length] == '\0';
+		}
+		char bytes[4];
+		std::size_t count;
+		for (std::size_t pos = m_stringBegin; pos < m_stringEnd;) {
+			pos += decode(m_text + pos, bytes, count);
+			for (std::size_t i = 0; i < count; ++i, ++text) {
+				/// an escaped NUL must not match the end of @p text
+				if (*text == '\0' || *text != bytes[i]) {
+					return false;
+				}
+			}
+		}
+		return *text == '\0';
+	}
+
+	void JsonReader::text(std::string &out) const {
+		if (!m_escaped) {
+			out.assign(m_text + m_stringBegin, m_stringEnd - m_stringBegin);
+			return;
+		}
+		out.clear();
+		char bytes[4];
+		std::size_t count;
+		for (std::size_t pos = m_stringBegin; pos < m_stringEnd;) {
+			pos += decode(m_text + pos, bytes, count);
+			out.append(bytes, count);
+		}
+	}
+
+	std::string JsonReader::where() const {
+		std::size_t line = 1;
+		std::size_t column = 1;
+		for (std::size_t i = 0; i < m_start && i < m_length; ++i) {
+			if (m_text[i] == '\n') {
+				++line;
+				column = 1;
+			} else {
+				++column;
+			}
+		}
+		std::ostringstream os;
+		os << "line " << line << ", column " << column;
+		if (m_error) {
+			os << ": " << m_error;
+		}
+		return os.str();
+	}
+
+	JsonReader::Event JsonReader::fail(const char *what) {
+		m_error = what;
+		m_start = m_pos;
+		return m_event = JSON_ERROR;
+	}
+
+	JsonReader::Event JsonReader::value() {
+		const char c = m_text[m_pos];
+		m_state = STATE_AFTER_VALUE;
+		if (c == '{' || c == '[') {
+			if (m_depth == MAX_DEPTH) {
+				return fail("nested too deeply");
+			}
+			m_stack[m_depth++] = c;
+			++m_pos;
+			m_state = c == '{' ? STATE_FIRST_KEY : STATE_FIRST_VALUE;
+			return m_event = c == '{' ? JSON_OBJECT_BEGIN : JSON_ARRAY_BEGIN;
+		}
+		if (c == '"') {
+			return scanString() ? (m_event = JSON_STRING) : m_event;
+		}
+		if (c == '-' || isDigit(c)) {
+			return scanNumber() ? (m_event = JSON_NUMBER) : m_event;
+		}
+		if (literal("true") || literal("false")) {
+			m_boolean = c == 't';
+			return m_event = JSON_BOOLEAN;
+		}
+		if (literal("null")) {
+			return m_event = JSON_NULL;
+		}
+		return fail("expected a value");
+	}
+
+	JsonReader::Event JsonReader::close(char closer) {
+		const char open = m_stack[m_depth - 1];
+		if (closer != (open == '{' ? '}' : ']')) {
+			return fail(open == '{' ? "expected ',' or '}'" : "expected ',' or ']'");
+		}
+		++m_pos;
+		--m_depth;
+		m_state = STATE_AFTER_VALUE;
+		return m_event = open == '{' ? JSON_OBJECT_END : JSON_ARRAY_END;
+	}
+
+	/*
+	 * Check the string starting at m_pos and note where its text lies;
+	 * nothing is decoded yet
+	 */
+	bool JsonReader::scanString() {
+		std::size_t pos = m_pos + 1;
+		m_escaped = false;
+		for (;;) {
+			if (pos >= m_length) {
+				fail("unterminated string");
+				return false;
+			}
+			const unsigned char c = static_cast<unsigned char>(m_text[pos]);
+			if (c == '"') {
+				break;
+			}
+			if (c < 0x20) {
+				m_pos = pos;
+				fail("control character in string");
+				return false;
+			}
+			if (c != '\\') {
+				++pos;
+				continue;
+			}
+			m_escaped = true;
+			if (pos + 1 >= m_length) {
+				fail("unterminated string");
+				return false;
+			}
+			const char kind = m_text[pos + 1];
+			if (kind != 'u') {
+				if (!std::strchr("\"\\/bfnrt", kind) || kind == '\0') {
+					m_pos = pos;
+					fail("invalid escape");
+					return false;
+				}
+				pos += 2;
+				continue;
+			}
+			const long code = pos + 6 <= m_length ? hex4(m_text + pos + 2) : -1;
+			if (code >= 0xD800 && code <= 0xDBFF) {
+				/// a high surrogate needs its low half
+				const long low = pos + 12 <= m_length && m_text[pos + 6] == '\\' && m_text[pos + 7] == 'u'
+					? hex4(m_text + pos + 8) : -1;
+				if (low < 0xDC00 || low > 0xDFFF) {
+					m_pos = pos;
+					fail("unpaired surrogate");
+					return false;
+				}
+				pos += 12;
+				continue;
+			}
+			if (code < 0 || (code >= 0xDC00 && code <= 0xDFFF)) {
+				m_pos = pos;
+				fail(code < 0 ? "invalid \\u escape" : "unpaired surrogate");
+				return false;
+			}
+			pos += 6;
+		}
+		m_stringBegin = m_pos + 1;
+		m_stringEnd = pos;
+		m_pos = pos + 1;
+		return true;
+	}
+
+	/*
+	 * JSON's number grammar, then the value regardless of the locale;
+	 * one that overflows a double is an error rather than infinity
+	 */
+	bool JsonReader::scanNumber() {
+		std::size_t pos = m_pos;
+		if (m_text[pos] == '-') {
+			++pos;
+		}
+		if (pos < m_length && m_text[pos] == '0') {
+			++pos;
+		} else if (pos < m_length && isDigit(m_text[pos])) {
+			while (pos < m_length && isDigit(m_text[pos])) {
+				++pos;
+			}
+		} else {
+			m_pos = pos;
+			fail("invalid number");
+			return false;
+		}
+		if (pos < m_length && m_text[pos] == '.') {
+			++pos;
+			if (pos >= m_length || !isDigit(m_text[pos])) {
+				m_pos = pos;
+				fail("invalid number");
+				return false;
+			}
+			while (pos < m_length && isDigit(m_text[pos])) {
+				++pos;
+			}
+		}
+		if (pos < m_length && (m_text[pos] == 'e' || m_text[pos] == 'E')) {
+			++pos;
+			if (pos < m_length && (m_text[pos] == '+' || m_text[pos] == '-')) {
+				++pos;
+			}
+			if (pos >= m_length || !isDigit(m_text[pos])) {
+				m_pos = pos;
+				fail("invalid number");
+				return false;
+			}
+			while (pos < m_length && isDigit(m_text[pos])) {
+				++pos;
+			}
+		}
+		if (pos - m_pos > MAX_DECIMAL_LENGTH) {
+			fail("number too long");
+			return false;
+		}
+		if (!parseDecimal(m_text + m_pos, m_text + pos, m_number)) {
+			fail("number out of range");
+			return false;
+		}
+		m_pos = pos;
+		return true;
+	}
+
+	bool JsonReader::literal(const char *word) {
+		const std::size_t length = std::strlen(word);
+		if (m_length - m_pos < length || std::memcmp(m_text + m_pos, word, length) != 0) {
+			return false;
+		}
+		m_pos += length;
+		return true;
+	}
+
+} // namespace motionplatform
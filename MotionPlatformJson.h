@@ -0,0 +1,132 @@
+/** @file
+	@brief Pull reader for JSON text: one pass over the text in place,
+	without allocating.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformJson_h_GUID_3B8E51F0_6C27_4D9A_A4E3_8F02D7C1B694
+#define INCLUDED_MotionPlatformJson_h_GUID_3B8E51F0_6C27_4D9A_A4E3_8F02D7C1B694
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+
+namespace motionplatform {
+
+	/// @brief Reads a JSON document as a sequence of events.
+	///
+	/// The caller asks for each event in turn and so walks the document in
+	/// the shape it expects, skipping what it does not know. Strings are
+	/// left in the text and only decoded when asked for, so reading
+	/// allocates nothing: the state is a fixed stack of MAX_DEPTH
+	/// containers. The text must outlive the reader.
+	///
+	/// Syntax errors are reported as JSON_ERROR, after which every call
+	/// returns it again.
+	class JsonReader : boost::noncopyable {
+	public:
+		enum Event {
+			JSON_OBJECT_BEGIN,
+			JSON_OBJECT_END,
+			JSON_ARRAY_BEGIN,
+			JSON_ARRAY_END,
+			JSON_KEY, ///< an object member's name; its value is next
+			JSON_STRING,
+			JSON_NUMBER,
+			JSON_BOOLEAN,
+			JSON_NULL,
+			JSON_END, ///< the whole document has been read
+			JSON_ERROR
+		};
+
+		/// Deepest nesting of objects and arrays read.
+		static const std::size_t MAX_DEPTH = 32;
+
+		JsonReader(const char *text, std::size_t length);
+
+		/// @brief Read the next event.
+		Event next();
+
+		/// @brief Read past the value that comes next, whole objects and
+		/// arrays included. False on a syntax error.
+		bool skip();
+
+		/// @brief After JSON_KEY or JSON_STRING: whether the decoded text is
+		/// exactly @p text.
+		bool equals(const char *text) const;
+
+		/// @brief After JSON_KEY or JSON_STRING: decode the text into @p out.
+		void text(std::string &out) const;
+
+		/// @brief After JSON_NUMBER.
+		double number() const { return m_number; }
+
+		/// @brief After JSON_BOOLEAN.
+		bool boolean() const { return m_boolean; }
+
+		/// @brief "line L, column C" of the last event, or of the syntax
+		/// error, and what was wrong with it.
+		std::string where() const;
+		const char *error() const { return m_error; }
+
+		/// @brief Byte offset where the last event's text begins, and just
+		/// past its end (for JSON_KEY, past the ':').
+		std::size_t begin() const { return m_start; }
+		std::size_t end() const { return m_pos; }
+
+	private:
+		enum State { STATE_VALUE, STATE_FIRST_KEY, STATE_KEY, STATE_FIRST_VALUE, STATE_AFTER_VALUE };
+
+		Event fail(const char *what);
+		Event value();
+		Event close(char closer);
+		bool scanString();
+		bool scanNumber();
+		bool literal(const char *word);
+
+		const char *m_text;
+		std::size_t m_length;
+		std::size_t m_pos;
+		State m_state;
+		char m_stack[MAX_DEPTH];
+		std::size_t m_depth;
+		Event m_event;
+		/// start of the last event's text, and for strings the text between
+		/// the quotes
+		std::size_t m_start;
+		std::size_t m_stringBegin;
+		std::size_t m_stringEnd;
+		bool m_escaped;
+		double m_number;
+		bool m_boolean;
+		const char *m_error;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformJson_h_GUID_3B8E51F0_6C27_4D9A_A4E3_8F02D7C1B694
@@ -0,0 +1,113 @@
+# Generates a header describing the channel layout declared in the plugin's
+# JSON descriptor, so the device can be built as a template over it, and a
+# header embedding the descriptor text itself, which
+# motionplatform::buildDescriptor patches for each seat and config.
+#
+# Run in script mode:
+#   cmake -DJSON_FILE=<descriptor.json> -DOUTPUT_FILE=<layout.h>
+#         -DJSON_HEADER=<json.h> -P MotionPlatformLayout.cmake
+#
+# Only the few fields the device depends on are extracted: interface counts and
+# the channels behind each semantic path. A descriptor the regexes cannot make
+# sense of stops the build rather than producing a wrong layout.
+
+file(READ "${JSON_FILE}" _json)
+
+function(_layout_extract var regex what)
+    string(REGEX MATCH "${regex}" _match "${_json}")
+    if(NOT _match)
+        message(FATAL_ERROR "${JSON_FILE}: could not find ${what}")
+    endif()
+    set(${var} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+endfunction()
+
+set(_ws "[ \t\r\n]*")
+_layout_extract(TRACKER_COUNT
+    "\"tracker\"${_ws}:${_ws}{[^}]*\"count\"${_ws}:${_ws}([0-9]+)"
+    "interfaces.tracker.count")
+_layout_extract(ANALOG_COUNT
+    "\"analog\"${_ws}:${_ws}{${_ws}\"count\"${_ws}:${_ws}([0-9]+)"
+    "interfaces.analog.count")
+_layout_extract(ORIENTATION_SENSOR
+    "\"current_orientation\"${_ws}:${_ws}\"tracker/([0-9]+)\""
+    "semantics.current_orientation")
+_layout_extract(TARGET_DISPLACEMENT_CHANNEL
+    "\"target_displacement\"${_ws}:${_ws}{${_ws}\"x\"${_ws}:${_ws}\"analog/([0-9]+)\""
+    "semantics.target_displacement.x")
+_layout_extract(TARGET_ANGLE_CHANNEL
+    "\"target_angle\"${_ws}:${_ws}{${_ws}\"x\"${_ws}:${_ws}\"analog/([0-9]+)\""
+    "semantics.target_angle.x")
+_layout_extract(SEQUENCE_CHANNEL
+    "\"sample_sequence\"${_ws}:${_ws}\"analog/([0-9]+)\""
+    "semantics.sample_sequence")
+
+# the device copies x/y/z as one block, so each group must be contiguous
+foreach(_group target_displacement target_angle)
+    foreach(_axis x y z)
+        _layout_extract(_${_group}_${_axis}
+            "\"${_group}\"${_ws}:${_ws}{[^}]*\"${_axis}\"${_ws}:${_ws}\"analog/([0-9]+)\""
+            "semantics.${_group}.${_axis}")
+    endforeach()
+    math(EXPR _y "${_${_group}_x} + 1")
+    math(EXPR _z "${_${_group}_x} + 2")
+    if(NOT _${_group}_y EQUAL _y OR NOT _${_group}_z EQUAL _z)
+        message(FATAL_ERROR "${JSON_FILE}: semantics.${_group} x/y/z must be consecutive analog channels")
+    endif()
+endforeach()
+
+get_filename_component(_json_name "${JSON_FILE}" NAME)
+set(_content "/** @file
+	@brief Channel layout generated from ${_json_name} - do not edit.
+*/
+
+#ifndef INCLUDED_MotionPlatformGeneratedLayout_h
+#define INCLUDED_MotionPlatformGeneratedLayout_h
+
+namespace motionplatform {
+	namespace generated {
+
+		/// @brief Interface counts and semantic channels of the JSON descriptor
+		struct DescriptorLayout {
+			static const unsigned TRACKER_COUNT = ${TRACKER_COUNT};
+			static const unsigned ANALOG_COUNT = ${ANALOG_COUNT};
+			static const unsigned ORIENTATION_SENSOR = ${ORIENTATION_SENSOR};
+			static const unsigned TARGET_DISPLACEMENT_CHANNEL = ${TARGET_DISPLACEMENT_CHANNEL};
+			static const unsigned TARGET_ANGLE_CHANNEL = ${TARGET_ANGLE_CHANNEL};
+			static const unsigned SEQUENCE_CHANNEL = ${SEQUENCE_CHANNEL};
+		};
+
+	} // namespace generated
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformGeneratedLayout_h
+")
+
+# only touch an output when it changes, to avoid needless rebuilds
+function(_layout_write file content)
+    if(EXISTS "${file}")
+        file(READ "${file}" _old)
+        if(_old STREQUAL content)
+            return()
+        endif()
+    endif()
+    file(WRITE "${file}" "${content}")
+endfunction()
+_layout_write("${OUTPUT_FILE}" "${_content}")
+
+# the descriptor text as a C string literal, one source line per json line
+string(REPLACE "\\" "\\\\" _literal "${_json}")
+string(REPLACE "\"" "\\\"" _literal "${_literal}")
+string(REPLACE "\r" "" _literal "${_literal}")
+string(REPLACE "\n" "\\n\"\n\"" _literal "${_literal}")
+_layout_write("${JSON_HEADER}" "/** @file
+	@brief Descriptor text embedded from ${_json_name} - do not edit.
+*/
+
+#ifndef INCLUDED_MotionPlatformGeneratedJson_h
+#define INCLUDED_MotionPlatformGeneratedJson_h
+
+static const char com_vectionvr_osvr_motionPlatformDevicePlugin_json[] =
+\"${_literal}\";
+
+#endif // INCLUDED_MotionPlatformGeneratedJson_h
+")
@@ -0,0 +1,862 @@
+/** @file
+	@brief Headless load generator: runs the plugin's simulation core without
+	an OSVR server and writes the samples to stdout, shared memory or a file.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformCallLog.h"
+#include "MotionPlatformConfig.h"
+#include "MotionPlatformCounters.h"
+#include "MotionPlatformExpression.h"
+#include "MotionPlatformNoise.h"
+#include "MotionPlatformScheduler.h"
+#include "MotionPlatformRecording.h"
+#include "MotionPlatformReplay.h"
+#include "MotionPlatformScript.h"
+#include "MotionPlatformSignal.h"
+#include "MotionPlatformStats.h"
+#include "MotionPlatformTrace.h"
+#include "MotionPlatformVibration.h"
+
+// Library/third-party includes
+#include <boost/algorithm/string/join.hpp>
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+	typedef boost::chrono::steady_clock Clock;
+	namespace ipc = boost::interprocess;
+
+	struct Options {
+		Options() : seats(1), rateHz(1000), workers(1), ticks(10000), seed(5489u),
+			output("null"), metricsPort(0), speed(1), seek(0), loopBegin(0), loopEnd(0), readAhead(4), scaling(false),
+			goldenUpdate(false) {}
+		std::size_t seats;
+		unsigned rateHz; ///< 0 runs unpaced
+		std::size_t workers;
+		boost::uint64_t ticks;
+		boost::uint32_t seed;
+		std::string output;
+		unsigned short metricsPort; ///< 0 disables the exporter
+		std::string traceFile; ///< empty disables phase tracing
+		std::string noise; ///< colored noise, empty for uniform random angles
+		std::string script; ///< played by every seat, empty for random motion
+		std::vector<std::string> replay; ///< recordings to replay merged, empty for none
+		double speed;
+		double seek;
+		double loopBegin;
+		double loopEnd;
+		std::size_t readAhead; ///< replay blocks decoded ahead, 0 for none
+		std::vector<std::string> signals; ///< NAME=SIGNAL test signals
+		std::vector<std::string> channels; ///< NAME=EXPRESSION overrides
+		std::vector<std::string> vibration; ///< vibration voices
+		std::vector<std::string> checkCalls; ///< call logs to digest and compare
+		bool scaling;
+		std::string golden; ///< golden file to check the run against, empty for none
+		bool goldenUpdate; ///< write the golden file instead of checking it
+		std::string goldenBuild; ///< build type this binary was built as, e.g. Release
+	};
+
+	/// @brief Destination for each tick's samples.
+	class Sink {
+	public:
+		virtual ~Sink() {}
+		virtual void write(std::vector<motionplatform::SampleRecord> const &samples) = 0;
+	};
+
+	class NullSink : public Sink {
+	public:
+		void write(std::vector<motionplatform::SampleRecord> const &) {}
+	};
+
+	/// One text line per seat and tick.
+	class StdoutSink : public Sink {
+	public:
+		void write(std::vector<motionplatform::SampleRecord> const &samples) {
+			for (std::size_t i = 0; i < samples.size(); ++i) {
+				motionplatform::SampleRecord const &s = samples[i];
+				std::printf("%llu %u %u %.6f %.6f %.6f %.6f",
+					static_cast<unsigned long long>(s.timestampUsec), s.tick, s.seat,
+					s.orientation[0], s.orientation[1], s.orientation[2], s.orientation[3]);
+				for (std::size_t c = 0; c < motionplatform::Simulation::ACTUATOR_COUNT; ++c) {
+					std::printf(" %.6f", s.actuators[c]);
+				}
+				std::printf("\n");
+			}
+		}
+	};
+
+	class FileSink : public Sink {
+	public:
+		FileSink(std::string const &path, Options const &opts)
+			: m_writer(path, static_cast<boost::uint32_t>(opts.seats), opts.rateHz) {}
+		bool isOpen() const { return m_writer.isOpen(); }
+		void write(std::vector<motionplatform::SampleRecord> const &samples) {
+			m_writer.appendTick(samples);
+		}
+
+	private:
+		motionplatform::RecordingWriter m_writer;
+	};
+
+	/// @brief The device calls the plugin makes for these samples: each
+	/// seat's descriptor once, then a pose and the analog channels (with the
+	/// tick as sample_sequence) per seat and tick.
+	class CallsSink : public Sink {
+	public:
+		CallsSink(motionplatform::CallSink &calls, Options const &opts) : m_calls(calls) {
+			motionplatform::Config config;
+			config.seats = opts.seats;
+			for (std::size_t seat = 0; seat < opts.seats; ++seat) {
+				const std::string descriptor = motionplatform::buildDescriptor(config, seat);
+				m_calls.descriptor(seat, descriptor.data(), descriptor.size());
+			}
+		}
+		void write(std::vector<motionplatform::SampleRecord> const &samples) {
+			double pose[motionplatform::CALL_POSE_VALUES] = { 0, 0, 0, 0, 0, 0, 0 };
+			double values[motionplatform::Simulation::ACTUATOR_COUNT + 1];
+			for (std::size_t i = 0; i < samples.size(); ++i) {
+				motionplatform::SampleRecord const &s = samples[i];
+				/// translation, then the rotation as w, x, y, z
+				pose[3] = s.orientation[3];
+				pose[4] = s.orientation[0];
+				pose[5] = s.orientation[1];
+				pose[6] = s.orientation[2];
+				m_calls.pose(s.seat, 0, pose);
+				for (std::size_t c = 0; c < motionplatform::Simulation::ACTUATOR_COUNT; ++c) {
+					values[c] = s.actuators[c];
+				}
+				values[motionplatform::Simulation::ACTUATOR_COUNT] = s.tick;
+				m_calls.analog(s.seat, values, motionplatform::Simulation::ACTUATOR_COUNT + 1);
+			}
+		}
+
+	private:
+		motionplatform::CallSink &m_calls;
+	};
+
+	/// Those calls into a call log file.
+	class CallLogSink : public Sink {
+	public:
+		CallLogSink(std::string const &path, Options const &opts) : m_log(path), m_calls(m_log, opts) {}
+		bool isOpen() const { return m_log.isOpen(); }
+		void write(std::vector<motionplatform::SampleRecord> const &samples) { m_calls.write(samples); }
+
+	private:
+		motionplatform::CallLogWriter m_log;
+		CallsSink m_calls;
+	};
+
+	/// @brief Ring of ticks in a named shared memory object.
+	///
+	/// A reader polls writeTick, then copies tick (writeTick - 1) from slot
+	/// (writeTick - 1) % capacityTicks. Ticks older than capacityTicks are
+	/// overwritten without waiting for readers.
+	class SharedMemorySink : public Sink {
+	public:
+		struct Header {
+			char magic[8];
+			boost::uint32_t recordSize;
+			boost::uint32_t seatCount;
+			boost::uint32_t capacityTicks;
+			boost::uint32_t reserved;
+			boost::atomic<boost::uint64_t> writeTick;
+		};
+
+		SharedMemorySink(std::string const &name, Options const &opts)
+			: m_name(name), m_seats(opts.seats), m_capacity(1024), m_written(0) {
+			ipc::shared_memory_object::remove(name.c_str());
+			ipc::shared_memory_object shm(ipc::create_only, name.c_str(), ipc::read_write);
+			shm.truncate(static_cast<ipc::offset_t>(sizeof(Header) +
+				m_capacity * m_seats * sizeof(motionplatform::SampleRecord)));
+			ipc::mapped_region region(shm, ipc::read_write);
+			m_region.swap(region);
+			m_header = new (m_region.get_address()) Header();
+			std::memcpy(m_header->magic, motionplatform::RECORDING_MAGIC, sizeof(m_header->magic));
+			m_header->recordSize = sizeof(motionplatform::SampleRecord);
+			m_header->seatCount = static_cast<boost::uint32_t>(m_seats);
+			m_header->capacityTicks = static_cast<boost::uint32_t>(m_capacity);
+			m_header->writeTick.store(0, boost::memory_order_release);
+			m_records = reinterpret_cast<motionplatform::SampleRecord *>(m_header + 1);
+		}
+
+		~SharedMemorySink() {
+			ipc::shared_memory_object::remove(m_name.c_str());
+		}
+
+		void write(std::vector<motionplatform::SampleRecord> const &samples) {
+			std::size_t slot = static_cast<std::size_t>(m_written % m_capacity);
+			std::memcpy(m_records + slot * m_seats, &samples[0],
+				samples.size() * sizeof(motionplatform::SampleRecord));
+			m_header->writeTick.store(++m_written, boost::memory_order_release);
+		}
+
+	private:
+		std::string m_name;
+		std::size_t m_seats;
+		std::size_t m_capacity;
+		boost::uint64_t m_written;
+		ipc::mapped_region m_region;
+		Header *m_header;
+		motionplatform::SampleRecord *m_records;
+	};
+
+	void printUsage() {
+		std::cerr << "Usage: MotionPlatformLoadGenerator [options]\n"
+			"  --seats N        number of simulated seats (default 1)\n"
+			"  --rate HZ        tick rate, 0 for unpaced (default 1000)\n"
+			"  --threads N      simulation worker threads (default 1)\n"
+			"  --ticks N        number of ticks to run (default 10000)\n"
+			"  --seed N         simulation seed (default 5489)\n"
+			"  --output SPEC    null, stdout, file:PATH, shm:NAME or calls:PATH, the\n"
+			"                   device calls the plugin would make (default null)\n"
+			"  --metrics-port N serve Prometheus metrics on 127.0.0.1:N while running\n"
+			"  --trace FILE     write a Chrome trace of every tick's phases to FILE\n"
+			"  --noise SPEC     colored noise for the target angles: pink RMS,\n"
+			"                   bandpass HZ Q RMS or ou RATE RMS\n"
+			"  --script TEXT    play a motion script on every seat, e.g.\n"
+			"                   \"ramp pitch 10 2; hold 1; oscillate roll 5 1 4; loop\"\n"
+			"  --replay FILE    replay a recording on the seats it has; repeat to\n"
+			"                   merge several by timestamp\n"
+			"  --speed X        replay rate, 0 pauses (default 1)\n"
+			"  --seek S         start the replay S seconds in\n"
+			"  --loop A:B       loop the replay between A and B seconds\n"
+			"  --read-ahead N   replay blocks decoded ahead on a thread of their\n"
+			"                   own, 0 reads each when reached (default 4)\n"
+			"  --signal N=SPEC  play a test signal on actuator channel N, e.g.\n"
+			"                   \"target_angle.x=chirp 0.1 20 60 0.5\" (repeatable)\n"
+			"  --vibration SPEC mix a vibration voice into its channel, e.g.\n"
+			"                   \"target_displacement.z sine 35 0.05\" (repeatable)\n"
+			"  --channel N=EXPR drive actuator channel N with an expression, e.g.\n"
+			"                   \"target_displacement.z=0.3*sin(2*pi*t)\" (repeatable)\n"
+			"  --scaling        report unpaced throughput for 1..threads workers\n"
+			"  --check-calls LOG replay a device call log into a digest; give it\n"
+			"                   twice to compare two logs call by call\n"
+			"  --golden FILE    run unpaced, then check the digest of the device calls\n"
+			"                   and the median per-tick cost against FILE; budgets\n"
+			"                   count the calling thread only, so use --threads 1\n"
+			"  --golden-update  write FILE from this run instead of checking it\n"
+			"  --golden-build TYPE build type of this binary; a check fails at once\n"
+			"                   if FILE was written by another build type\n";
+	}
+
+	bool parseOptions(int argc, char *argv[], Options &opts) {
+		try {
+			for (int i = 1; i < argc; ++i) {
+				std::string arg(argv[i]);
+				if (arg == "--scaling") {
+					opts.scaling = true;
+					continue;
+				}
+				if (arg == "--golden-update") {
+					opts.goldenUpdate = true;
+					continue;
+				}
+				if (i + 1 >= argc) {
+					return false;
+				}
+				std::string value(argv[++i]);
+				if (arg == "--seats") {
+					opts.seats = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--rate") {
+					opts.rateHz = boost::lexical_cast<unsigned>(value);
+				} else if (arg == "--threads") {
+					opts.workers = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--ticks") {
+					opts.ticks = boost::lexical_cast<boost::uint64_t>(value);
+				} else if (arg == "--seed") {
+					opts.seed = boost::lexical_cast<boost::uint32_t>(value);
+				} else if (arg == "--output") {
+					opts.output = value;
+				} else if (arg == "--trace") {
+					opts.traceFile = value;
+				} else if (arg == "--noise") {
+					opts.noise = value;
+				} else if (arg == "--script") {
+					opts.script = value;
+				} else if (arg == "--replay") {
+					opts.replay.push_back(value);
+				} else if (arg == "--speed") {
+					opts.speed = boost::lexical_cast<double>(value);
+				} else if (arg == "--seek") {
+					opts.seek = boost::lexical_cast<double>(value);
+				} else if (arg == "--loop") {
+					std::string::size_type colon = value.find(':');
+					if (colon == std::string::npos) {
+						return false;
+					}
+					opts.loopBegin = boost::lexical_cast<double>(value.substr(0, colon));
+					opts.loopEnd = boost::lexical_cast<double>(value.substr(colon + 1));
+				} else if (arg == "--read-ahead") {
+					opts.readAhead = boost::lexical_cast<std::size_t>(value);
+				} else if (arg == "--signal") {
+					opts.signals.push_back(value);
+				} else if (arg == "--vibration") {
+					opts.vibration.push_back(value);
+				} else if (arg == "--channel") {
+					opts.channels.push_back(value);
+				} else if (arg == "--check-calls") {
+					opts.checkCalls.push_back(value);
+				} else if (arg == "--golden") {
+					opts.golden = value;
+				} else if (arg == "--golden-build") {
+					opts.goldenBuild = value;
+				} else if (arg == "--metrics-port") {
+					opts.metricsPort = boost::lexical_cast<unsigned short>(value);
+				} else {
+					return false;
+				}
+			}
+		} catch (boost::bad_lexical_cast const &) {
+			return false;
+		}
+		return opts.seats > 0 && opts.seats <= 0xffff && opts.workers > 0 && opts.checkCalls.size() <= 2 &&
+			(!opts.goldenUpdate || !opts.golden.empty());
+	}
+
+	Sink *createSink(Options const &opts) {
+		std::string const &out = opts.output;
+		if (out == "null") {
+			return new NullSink();
+		}
+		if (out == "stdout") {
+			return new StdoutSink();
+		}
+		if (out.compare(0, 5, "file:") == 0) {
+			FileSink *sink = new FileSink(out.substr(5), opts);
+			if (!sink->isOpen()) {
+				delete sink;
+				return NULL;
+			}
+			return sink;
+		}
+		if (out.compare(0, 6, "calls:") == 0) {
+			CallLogSink *sink = new CallLogSink(out.substr(6), opts);
+			if (!sink->isOpen()) {
+				delete sink;
+				return NULL;
+			}
+			return sink;
+		}
+		if (out.compare(0, 4, "shm:") == 0) {
+			try {
+				return new SharedMemorySink(out.substr(4), opts);
+			} catch (ipc::interprocess_exception const &e) {
+				std::cerr << "MPS_LOADGEN > " << e.what() << std::endl;
+				return NULL;
+			}
+		}
+		return NULL;
+	}
+
+	double percentile(std::vector<double> &values, double p) {
+		if (values.empty()) {
+			return 0;
+		}
+		std::size_t n = static_cast<std::size_t>(p * (values.size() - 1));
+		std::nth_element(values.begin(), values.begin() + n, values.end());
+		return values[n];
+	}
+
+	/// @brief What a golden file records about the run it was written from.
+	struct Golden {
+		Golden() : digest(0), hasDigest(false), instructions(0), cpuUsec(0) {}
+		std::string build;
+		boost::uint64_t digest;
+		bool hasDigest;
+		double instructions; ///< median per update, 0 if not counted
+		double cpuUsec; ///< low percentile per update
+	};
+
+	/// Headroom over the recorded instructions per update. Instruction
+	/// counts barely move between runs, so this catches real regressions.
+	const double GOLDEN_INSTRUCTION_TOLERANCE = 1.10;
+	/// Headroom over the recorded CPU time per update, only used when
+	/// instructions cannot be counted. CPU time moves with frequency scaling,
+	/// cache sharing and other tenants, so this only catches gross slowdowns.
+	const double GOLDEN_CPU_TOLERANCE = 2.0;
+	/// CPU time is compared at a low percentile: interference only ever adds
+	/// time, so the fast updates are the steadiest estimate of the cost.
+	const double GOLDEN_CPU_PERCENTILE = 0.10;
+
+	bool readGolden(std::string const &path, Golden &golden) {
+		std::ifstream in(path.c_str());
+		if (!in) {
+			std::cerr << "MPS_LOADGEN > Could not read golden file " << path << std::endl;
+			return false;
+		}
+		std::string line;
+		while (std::getline(in, line)) {
+			std::istringstream fields(line);
+			std::string key;
+			if (!(fields >> key) || key[0] == '#') {
+				continue;
+			}
+			if (key == "build") {
+				fields >> golden.build;
+			} else if (key == "digest") {
+				golden.hasDigest = static_cast<bool>(fields >> std::hex >> golden.digest);
+			} else if (key == "instructions") {
+				fields >> golden.instructions;
+			} else if (key == "cpu_us") {
+				fields >> golden.cpuUsec;
+			}
+		}
+		if (!golden.hasDigest) {
+			std::cerr << "MPS_LOADGEN > " << path << " holds no digest" << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	/*
+	 * Before a golden check runs: the costs in the file are only comparable
+	 * with a binary of the build type that wrote it
+	 */
+	bool checkGoldenBuild(Options const &opts, Golden const &golden) {
+		if (golden.build.empty() || golden.build == opts.goldenBuild) {
+			return true;
+		}
+		std::cerr << "MPS_LOADGEN > " << opts.golden << " was written by a " << golden.build
+			<< " build, this is a " << (opts.goldenBuild.empty() ? std::string("unknown") : opts.goldenBuild)
+			<< " build; configure with -DCMAKE_BUILD_TYPE=" << golden.build << std::endl;
+		return false;
+	}
+
+	/*
+	 * Compare this run with @p golden, or write it to opts.golden with
+	 * --golden-update: the digest must match exactly. Where instructions are
+	 * counted on both sides the median per update must stay within
+	 * GOLDEN_INSTRUCTION_TOLERANCE of the recorded one, and CPU time is only
+	 * reported; otherwise CPU time is held to GOLDEN_CPU_TOLERANCE
+	 */
+	int finishGolden(Options const &opts, Golden const &golden, motionplatform::DigestSink const &digest,
+		bool hardware, std::vector<double> &instructions, std::vector<double> &cpuUsec) {
+		const double medianInstructions = percentile(instructions, 0.5);
+		const double lowCpuUsec = percentile(cpuUsec, GOLDEN_CPU_PERCENTILE);
+		std::cerr << "MPS_LOADGEN > golden: digest " << std::hex << std::setw(16) << std::setfill('0')
+			<< digest.digest() << std::dec << ", per update " << lowCpuUsec << " us CPU (p"
+			<< GOLDEN_CPU_PERCENTILE * 100 << ")";
+		if (hardware) {
+			std::cerr << ", " << medianInstructions << " instructions (median)";
+		}
+		std::cerr << std::endl;
+		if (opts.goldenUpdate) {
+			std::ofstream out(opts.golden.c_str());
+			out << "# MotionPlatformLoadGenerator golden run: " << opts.seats << " seats, " << opts.ticks
+				<< " ticks, seed " << opts.seed << ", " << opts.workers << " threads\n";
+			if (!opts.goldenBuild.empty()) {
+				out << "build " << opts.goldenBuild << "\n";
+			}
+			out << "digest " << std::hex << std::setw(16) << std::setfill('0') << digest.digest() << std::dec << "\n";
+			if (hardware) {
+				out << "instructions " << static_cast<boost::uint64_t>(medianInstructions) << "\n";
+			}
+			out << "cpu_us " << lowCpuUsec << "\n";
+			if (!out) {
+				std::cerr << "MPS_LOADGEN > Could not write golden file " << opts.golden << std::endl;
+				return 1;
+			}
+			std::cerr << "MPS_LOADGEN > wrote " << opts.golden << std::endl;
+			return 0;
+		}
+		int status = 0;
+		if (digest.digest() != golden.digest) {
+			std::cerr << "MPS_LOADGEN > FAIL: output differs from " << opts.golden << ", expected digest "
+				<< std::hex << std::setw(16) << std::setfill('0') << golden.digest << std::dec << std::endl;
+			status = 1;
+		}
+		if (hardware && golden.instructions > 0) {
+			const double budget = golden.instructions * GOLDEN_INSTRUCTION_TOLERANCE;
+			if (medianInstructions > budget) {
+				std::cerr << "MPS_LOADGEN > FAIL: " << medianInstructions << " instructions per update, budget "
+					<< budget << std::endl;
+				status = 1;
+			}
+		} else if (golden.cpuUsec > 0) {
+			const double budget = golden.cpuUsec * GOLDEN_CPU_TOLERANCE;
+			if (lowCpuUsec > budget) {
+				std::cerr << "MPS_LOADGEN > FAIL: " << lowCpuUsec << " us CPU per update, budget " << budget
+					<< std::endl;
+				status = 1;
+			}
+		}
+		if (status == 0) {
+			std::cerr << "MPS_LOADGEN > golden check passed" << std::endl;
+		}
+		return status;
+	}
+
+	/*
+	 * Run the simulation for opts.ticks ticks, paced at opts.rateHz; a
+	 * golden run is unpaced, with the tick length of that rate
+	 */
+	int run(Options const &opts) {
+		Golden golden;
+		if (!opts.golden.empty() && !opts.goldenUpdate &&
+			(!readGolden(opts.golden, golden) || !checkGoldenBuild(opts, golden))) {
+			return 1;
+		}
+		/// a golden run digests the device calls in place of the output
+		motionplatform::DigestSink digest;
+		boost::scoped_ptr<Sink> sink(opts.golden.empty() ? createSink(opts) : new CallsSink(digest, opts));
+		if (!sink) {
+			std::cerr << "MPS_LOADGEN > Could not open output " << opts.output << std::endl;
+			return 1;
+		}
+		/// the trace outlives the scheduler's workers, which record into it
+		boost::scoped_ptr<motionplatform::Trace> trace;
+		if (!opts.traceFile.empty()) {
+			trace.reset(new motionplatform::Trace(opts.traceFile));
+			if (!trace->isOpen()) {
+				std::cerr << "MPS_LOADGEN > Could not open trace file " << opts.traceFile << std::endl;
+				return 1;
+			}
+		}
+		const double dt = opts.rateHz ? 1.0 / opts.rateHz : 0.001;
+		motionplatform::SimulationPtr sim =
+			boost::make_shared<motionplatform::Simulation>(opts.seats, opts.seed);
+		sim->setTrace(trace.get());
+		/// likewise the noise generator, script and replay players
+		boost::scoped_ptr<motionplatform::NoiseGenerator> noise;
+		if (!opts.noise.empty()) {
+			noise.reset(new motionplatform::NoiseGenerator(opts.seats, 1.0 / dt, opts.seed));
+			std::string error;
+			if (!noise->configure(opts.noise, error)) {
+				std::cerr << "MPS_LOADGEN > Invalid noise: " << error << std::endl;
+				return 1;
+			}
+			sim->setNoise(noise.get());
+		}
+		boost::scoped_ptr<motionplatform::ScriptPlayer> scripts;
+		if (!opts.script.empty()) {
+			boost::shared_ptr<motionplatform::Script> script = boost::make_shared<motionplatform::Script>();
+			std::string error;
+			if (!motionplatform::parseScript(opts.script, *script, error)) {
+				std::cerr << "MPS_LOADGEN > Invalid script: " << error << std::endl;
+				return 1;
+			}
+			scripts.reset(new motionplatform::ScriptPlayer(opts.seats, sim->maxAngle()));
+			for (std::size_t seat = 0; seat < opts.seats; ++seat) {
+				scripts->assign(seat, script);
+			}
+			sim->setScripts(scripts.get());
+		}
+		boost::scoped_ptr<motionplatform::ReplayPlayer> replay;
+		if (!opts.replay.empty()) {
+			replay.reset(new motionplatform::ReplayPlayer(opts.replay, opts.seats, opts.readAhead));
+			if (!replay->isOpen()) {
+				std::cerr << "MPS_LOADGEN > Could not replay " << boost::algorithm::join(opts.replay, ", ") << std::endl;
+				return 1;
+			}
+			replay->seek(opts.seek);
+			replay->setSpeed(opts.speed);
+			replay->setLoop(opts.loopBegin, opts.loopEnd);
+			sim->setReplay(replay.get());
+		}
+		motionplatform::SignalGenerator signals;
+		for (std::size_t i = 0; i < opts.signals.size(); ++i) {
+			std::string::size_type eq = opts.signals[i].find('=');
+			int channel = motionplatform::channelIndex(opts.signals[i].substr(0, eq));
+			std::string error("unknown channel");
+			if (eq == std::string::npos || channel < 0 ||
+				!signals.add(static_cast<std::size_t>(channel), opts.signals[i].substr(eq + 1), error)) {
+				std::cerr << "MPS_LOADGEN > Invalid --signal " << opts.signals[i] << ": " << error << std::endl;
+				return 1;
+			}
+		}
+		if (!signals.empty()) {
+			if (signals.maxFrequency() * dt >= 0.5) {
+				std::cerr << "MPS_LOADGEN > Warning: signals reach " << signals.maxFrequency()
+					<< " Hz, above half the tick rate" << std::endl;
+			}
+			sim->setSignals(&signals);
+		}
+		motionplatform::VibrationBank vibration(opts.seats, 1.0 / dt, opts.seed);
+		for (std::size_t i = 0; i < opts.vibration.size(); ++i) {
+			std::string error;
+			if (!vibration.addVoice(opts.vibration[i], error)) {
+				std::cerr << "MPS_LOADGEN > Invalid --vibration " << opts.vibration[i] << ": " << error << std::endl;
+				return 1;
+			}
+		}
+		if (vibration.voiceCount() > 0) {
+			sim->setVibration(&vibration);
+		}
+		motionplatform::ExpressionSet expressions;
+		for (std::size_t i = 0; i < opts.channels.size(); ++i) {
+			std::string::size_type eq = opts.channels[i].find('=');
+			int channel = motionplatform::channelIndex(opts.channels[i].substr(0, eq));
+			std::string error("unknown channel");
+			if (eq == std::string::npos || channel < 0 ||
+				!expressions.add(static_cast<std::size_t>(channel), opts.channels[i].substr(eq + 1), error)) {
+				std::cerr << "MPS_LOADGEN > Invalid --channel " << opts.channels[i] << ": " << error << std::endl;
+				return 1;
+			}
+		}
+		if (!expressions.empty()) {
+			sim->setExpressions(&expressions);
+		}
+		motionplatform::Scheduler scheduler(sim, opts.workers);
+		motionplatform::StatsPtr stats = boost::make_shared<motionplatform::Stats>();
+		stats->seats.store(opts.seats);
+		boost::scoped_ptr<motionplatform::StatsExporter> exporter;
+		if (opts.metricsPort) {
+			try {
+				exporter.reset(new motionplatform::StatsExporter(stats, opts.metricsPort));
+			} catch (boost::system::system_error const &e) {
+				std::cerr << "MPS_LOADGEN > Could not serve metrics: " << e.what() << std::endl;
+				return 1;
+			}
+		}
+		std::vector<motionplatform::SampleRecord> samples;
+		std::vector<double> lateness; // microseconds past each tick's deadline
+		lateness.reserve(static_cast<std::size_t>(opts.ticks));
+
+		const bool goldenRun = !opts.golden.empty();
+		const bool paced = opts.rateHz && !goldenRun;
+		motionplatform::ThreadCounters counters;
+		std::vector<double> updateInstructions;
+		std::vector<double> updateCpuUsec;
+		if (goldenRun) {
+			updateInstructions.reserve(static_cast<std::size_t>(opts.ticks));
+			updateCpuUsec.reserve(static_cast<std::size_t>(opts.ticks));
+		}
+
+		const Clock::duration period = paced
+			? Clock::duration(boost::chrono::nanoseconds(1000000000LL / opts.rateHz))
+			: Clock::duration::zero();
+		const Clock::time_point start = Clock::now();
+		Clock::time_point deadline = start;
+		double busyUsec = 0;
+
+		for (boost::uint64_t t = 0; t < opts.ticks; ++t) {
+			const boost::uint64_t next = sim->tick() + 1;
+			Clock::time_point sleepStart = Clock::now();
+			if (paced) {
+				deadline += period;
+				boost::this_thread::sleep_until(deadline);
+			}
+			Clock::time_point wake = Clock::now();
+			if (paced) {
+				lateness.push_back(boost::chrono::duration<double, boost::micro>(wake - deadline).count());
+				stats->tickLateness.observe(lateness.back());
+				if (trace) {
+					trace->record("sleep", next, trace->toNsec(sleepStart), trace->toNsec(std::min(deadline, wake)));
+					if (wake > deadline) {
+						trace->record("wake", next, trace->toNsec(deadline), trace->toNsec(wake));
+					}
+				}
+			}
+			boost::uint64_t minorBefore, majorBefore, minorAfter, majorAfter;
+			motionplatform::ThreadCounters::Reading before, after;
+			scheduler.pageFaults(minorBefore, majorBefore);
+			if (goldenRun) {
+				counters.read(before);
+			}
+			{
+				motionplatform::TraceScope scope(trace.get(), "update", next);
+				scheduler.step(dt);
+			}
+			if (goldenRun) {
+				counters.read(after);
+			}
+			scheduler.pageFaults(minorAfter, majorAfter);
+			if (goldenRun) {
+				updateInstructions.push_back(static_cast<double>(after.instructions - before.instructions));
+				updateCpuUsec.push_back((after.cpuNsec - before.cpuNsec) * 1.0e-3);
+			}
+			Clock::time_point updated = Clock::now();
+			motionplatform::TraceScope sendScope(trace.get(), "send", next);
+			stats->tickUpdate.observe(boost::chrono::duration<double, boost::micro>(updated - wake).count());
+			boost::uint64_t stamp = static_cast<boost::uint64_t>(
+				boost::chrono::duration_cast<boost::chrono::microseconds>(wake - start).count());
+			motionplatform::captureTick(*sim, stamp, samples);
+			sink->write(samples);
+			stats->send.observe(boost::chrono::duration<double, boost::micro>(Clock::now() - updated).count());
+			motionplatform::Stats::add(stats->ticks);
+			motionplatform::Stats::add(stats->samplesSent, samples.size());
+			stats->stolenChunks.store(scheduler.stolenChunks(), boost::memory_order_relaxed);
+			motionplatform::Stats::add(stats->tickMinorFaults, minorAfter - minorBefore);
+			motionplatform::Stats::add(stats->tickMajorFaults, majorAfter - majorBefore);
+			if (replay) {
+				stats->replayPrefetched.store(replay->prefetched(), boost::memory_order_relaxed);
+				stats->replayMisses.store(replay->misses(), boost::memory_order_relaxed);
+			}
+			busyUsec += boost::chrono::duration<double, boost::micro>(Clock::now() - wake).count();
+		}
+
+		double elapsed = boost::chrono::duration<double>(Clock::now() - start).count();
+		double samplesTotal = static_cast<double>(opts.ticks) * opts.seats;
+		std::cerr << "MPS_LOADGEN > " << opts.ticks << " ticks x " << opts.seats << " seats in "
+			<< elapsed << " s: " << samplesTotal / elapsed << " samples/s, "
+			<< samplesTotal * sizeof(motionplatform::SampleRecord) / elapsed / 1.0e6 << " MB/s, "
+			<< busyUsec / opts.ticks << " us busy per tick" << std::endl;
+		if (!lateness.empty()) {
+			double mean = 0;
+			for (std::size_t i = 0; i < lateness.size(); ++i) {
+				mean += lateness[i];
+			}
+			mean /= lateness.size();
+			std::cerr << "MPS_LOADGEN > jitter (us late): mean " << mean
+				<< " p50 " << percentile(lateness, 0.50)
+				<< " p99 " << percentile(lateness, 0.99)
+				<< " p99.9 " << percentile(lateness, 0.999)
+				<< " max " << *std::max_element(lateness.begin(), lateness.end()) << std::endl;
+		}
+		std::cerr << "MPS_LOADGEN > page faults while updating: " << stats->tickMinorFaults.load()
+			<< " minor, " << stats->tickMajorFaults.load() << " major" << std::endl;
+		if (replay) {
+			std::cerr << "MPS_LOADGEN > replay blocks: " << replay->prefetched() << " prefetched, "
+				<< replay->misses() << " read on the tick thread" << std::endl;
+		}
+		if (goldenRun) {
+			return finishGolden(opts, golden, digest, counters.hardware(), updateInstructions, updateCpuUsec);
+		}
+		return 0;
+	}
+
+	/*
+	 * Unpaced ticks per second for every worker count up to opts.workers
+	 */
+	int runScaling(Options const &opts) {
+		double baseline = 0;
+		for (std::size_t workers = 1; workers <= opts.workers; ++workers) {
+			motionplatform::SimulationPtr sim =
+				boost::make_shared<motionplatform::Simulation>(opts.seats, opts.seed);
+			motionplatform::Scheduler scheduler(sim, workers);
+			Clock::time_point start = Clock::now();
+			for (boost::uint64_t t = 0; t < opts.ticks; ++t) {
+				scheduler.step(0.001);
+			}
+			double elapsed = boost::chrono::duration<double>(Clock::now() - start).count();
+			double rate = opts.ticks / elapsed;
+			if (workers == 1) {
+				baseline = rate;
+			}
+			std::cout << "workers " << workers << ": " << rate << " ticks/s, "
+				<< 1.0e6 / rate << " us/tick, speedup " << rate / baseline
+				<< ", efficiency " << rate / baseline / workers
+				<< ", stolen chunks " << scheduler.stolenChunks() << std::endl;
+		}
+		return 0;
+	}
+
+	const char *callName(boost::uint16_t kind) {
+		switch (kind) {
+		case motionplatform::CALL_DESCRIPTOR:
+			return "descriptor";
+		case motionplatform::CALL_POSE:
+			return "pose";
+		case motionplatform::CALL_ANALOG:
+			return "analog";
+		}
+		return "unknown";
+	}
+
+	/*
+	 * Replay each call log of opts.checkCalls into a digest and, given two,
+	 * compare them call by call; arguments must match bit for bit, times
+	 * are only reported
+	 */
+	int checkCalls(Options const &opts) {
+		for (std::size_t i = 0; i < opts.checkCalls.size(); ++i) {
+			motionplatform::CallLogReader log(opts.checkCalls[i]);
+			if (!log.isOpen()) {
+				std::cerr << "MPS_LOADGEN > Could not read call log " << opts.checkCalls[i] << std::endl;
+				return 1;
+			}
+			motionplatform::DigestSink digest;
+			const bool complete = motionplatform::replayCalls(log, digest);
+			motionplatform::CallLogReader timing(opts.checkCalls[i]);
+			motionplatform::CallView call;
+			boost::uint64_t lastNsec = 0;
+			while (timing.next(call)) {
+				lastNsec = call.timeNsec;
+			}
+			std::cerr << "MPS_LOADGEN > " << opts.checkCalls[i] << ": " << digest.descriptors() << " descriptors, "
+				<< digest.poses() << " poses, " << digest.analogs() << " analog updates over "
+				<< lastNsec * 1.0e-9 << " s, digest " << std::hex << std::setw(16) << std::setfill('0')
+				<< digest.digest() << std::dec << std::endl;
+			if (!complete) {
+				std::cerr << "MPS_LOADGEN > " << opts.checkCalls[i] << " is cut short or holds an unknown call" << std::endl;
+				return 1;
+			}
+		}
+		if (opts.checkCalls.size() < 2) {
+			return 0;
+		}
+		motionplatform::CallLogReader first(opts.checkCalls[0]);
+		motionplatform::CallLogReader second(opts.checkCalls[1]);
+		motionplatform::CallView a, b;
+		for (boost::uint64_t index = 0;; ++index) {
+			const bool hasA = first.next(a);
+			const bool hasB = second.next(b);
+			if (!hasA || !hasB) {
+				if (hasA != hasB) {
+					std::cerr << "MPS_LOADGEN > " << opts.checkCalls[hasA ? 1 : 0] << " ends at call " << index << std::endl;
+					return 1;
+				}
+				std::cerr << "MPS_LOADGEN > identical: " << index << " calls" << std::endl;
+				return 0;
+			}
+			if (a.kind != b.kind || a.seat != b.seat || a.size != b.size ||
+				std::memcmp(a.arguments, b.arguments, a.size) != 0) {
+				std::cerr << "MPS_LOADGEN > first difference at call " << index << ": " << callName(a.kind)
+					<< " of seat " << a.seat << " vs " << callName(b.kind) << " of seat " << b.seat << std::endl;
+				return 1;
+			}
+		}
+	}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+	Options opts;
+	if (!parseOptions(argc, argv, opts)) {
+		printUsage();
+		return 1;
+	}
+	if (!opts.checkCalls.empty()) {
+		return checkCalls(opts);
+	}
+	return opts.scaling ? runScaling(opts) : run(opts);
+}
@@ -0,0 +1,214 @@
+/** @file
+	@brief Implementation of the colored noise generator.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformNoise.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace motionplatform {
+
+	namespace {
+
+		/// samples run through a filter to measure its gain, here and in
+		/// VibrationBank
+		const std::size_t CALIBRATION_SAMPLES = 1 << 15;
+
+	} // namespace
+
+	BandPass BandPass::design(double frequency, double q, double rateHz) {
+		const double w0 = 2 * boost::math::constants::pi<double>() * frequency / rateHz;
+		const double alpha = std::sin(w0) / (2 * q);
+		const double a0 = 1 + alpha;
+		BandPass filter;
+		filter.b0 = static_cast<float>(alpha / a0);
+		filter.b2 = static_cast<float>(-alpha / a0);
+		filter.a1 = static_cast<float>(-2 * std::cos(w0) / a0);
+		filter.a2 = static_cast<float>((1 - alpha) / a0);
+		return filter;
+	}
+
+	double BandPass::whiteNoiseRms(boost::uint32_t state) const {
+		float z1 = 0, z2 = 0;
+		double sum = 0;
+		for (std::size_t i = 0; i < CALIBRATION_SAMPLES; ++i) {
+			const float y = step(fastNormal(state), z1, z2);
+			sum += static_cast<double>(y) * y;
+		}
+		return std::sqrt(sum / CALIBRATION_SAMPLES);
+	}
+
+	NoiseGenerator::NoiseGenerator(std::size_t seatCount, double rateHz, boost::uint32_t seed)
+		: m_seatCount(seatCount), m_rateHz(rateHz), m_seed(seed), m_mode(OU), m_gain(0),
+		m_b0(0), m_b2(0), m_a1(0), m_a2(0),
+		m_rng(3 * seatCount), m_s0(3 * seatCount), m_s1(3 * seatCount), m_s2(3 * seatCount) {
+		reset();
+	}
+
+	bool NoiseGenerator::configure(std::string const &spec, std::string &error) {
+		std::istringstream is(spec);
+		std::string kind;
+		is >> kind;
+		Mode mode;
+		double rms = 0, frequency = 0, q = 0, rate = 0;
+		if (kind == "pink") {
+			mode = PINK;
+			is >> rms;
+		} else if (kind == "bandpass") {
+			mode = BANDPASS;
+			is >> frequency >> q >> rms;
+		} else if (kind == "ou") {
+			mode = OU;
+			is >> rate >> rms;
+		} else {
+			error = "unknown noise '" + kind + "'";
+			return false;
+		}
+		std::string extra;
+		if (is.fail() || (is >> extra)) {
+			error = "wrong arguments for " + kind;
+			return false;
+		}
+		if (!(rms >= 0)) {
+			error = "rms must not be negative";
+			return false;
+		}
+		if (mode == BANDPASS && !(frequency > 0 && frequency * 2 < m_rateHz && q > 0)) {
+			error = "band-pass center must be within (0, rate / 2) and q positive";
+			return false;
+		}
+		if (mode == OU && !(rate > 0)) {
+			error = "ou rate must be positive";
+			return false;
+		}
+
+		m_mode = mode;
+		BandPass bandPass = BandPass();
+		if (mode == BANDPASS) {
+			bandPass = BandPass::design(frequency, q, m_rateHz);
+			m_b0 = bandPass.b0;
+			m_b2 = bandPass.b2;
+			m_a1 = bandPass.a1;
+			m_a2 = bandPass.a2;
+		} else if (mode == OU) {
+			/// x' = a x + sqrt(1 - a^2) w keeps a unit stationary variance
+			const double a = std::exp(-rate / m_rateHz);
+			m_a1 = static_cast<float>(a);
+			m_b0 = static_cast<float>(std::sqrt(1 - a * a));
+		}
+		reset();
+		if (mode == BANDPASS) {
+			/// measured on lane 0's noise, like calibrate() does for pink
+			m_gain = static_cast<float>(rms) / static_cast<float>(bandPass.whiteNoiseRms(m_rng[0]));
+		} else {
+			m_gain = static_cast<float>(rms) / (mode == OU ? 1.0f : calibrate());
+			reset();
+		}
+		return true;
+	}
+
+	/*
+	 * Reseed every lane and clear the filters
+	 */
+	void NoiseGenerator::reset() {
+		boost::mt19937 seeder(m_seed);
+		for (std::size_t i = 0; i < m_rng.size(); ++i) {
+			m_rng[i] = seedLane(seeder());
+		}
+		std::fill(m_s0.begin(), m_s0.end(), 0.0f);
+		std::fill(m_s1.begin(), m_s1.end(), 0.0f);
+		std::fill(m_s2.begin(), m_s2.end(), 0.0f);
+	}
+
+	/*
+	 * RMS of the pink filter's response to the white noise, on lane 0
+	 */
+	float NoiseGenerator::calibrate() {
+		double sum = 0;
+		for (std::size_t i = 0; i < CALIBRATION_SAMPLES; ++i) {
+			float y;
+			filter(0, 1, &y);
+			sum += static_cast<double>(y) * y;
+		}
+		return static_cast<float>(std::sqrt(sum / CALIBRATION_SAMPLES));
+	}
+
+	void NoiseGenerator::generate(std::size_t begin, std::size_t end, float maxAngle, float *pitch, float *yaw, float *roll) {
+		float *out[3] = { pitch, yaw, roll };
+		for (std::size_t axis = 0; axis < 3; ++axis) {
+			float *angles = out[axis] + begin;
+			const std::size_t count = end - begin;
+			filter(axis * m_seatCount + begin, count, angles);
+			for (std::size_t i = 0; i < count; ++i) {
+				angles[i] = std::max(-maxAngle, std::min(maxAngle, angles[i] * m_gain));
+			}
+		}
+	}
+
+	/*
+	 * Advance lanes [lane, lane + count) by one sample each, unscaled
+	 */
+	void NoiseGenerator::filter(std::size_t lane, std::size_t count, float *out) {
+		boost::uint32_t *rng = &m_rng[lane];
+		float *s0 = &m_s0[lane];
+		float *s1 = &m_s1[lane];
+		float *s2 = &m_s2[lane];
+		switch (m_mode) {
+		case PINK:
+			for (std::size_t i = 0; i < count; ++i) {
+				const float w = fastNormal(rng[i]);
+				s0[i] = 0.99765f * s0[i] + w * 0.0990460f;
+				s1[i] = 0.96300f * s1[i] + w * 0.2965164f;
+				s2[i] = 0.57000f * s2[i] + w * 1.0526913f;
+				out[i] = s0[i] + s1[i] + s2[i] + w * 0.1848f;
+			}
+			break;
+		case BANDPASS:
+			// transposed direct form II, b1 is zero
+			for (std::size_t i = 0; i < count; ++i) {
+				const float w = fastNormal(rng[i]);
+				const float y = m_b0 * w + s0[i];
+				s0[i] = s1[i] - m_a1 * y;
+				s1[i] = m_b2 * w - m_a2 * y;
+				out[i] = y;
+			}
+			break;
+		case OU:
+			for (std::size_t i = 0; i < count; ++i) {
+				const float w = fastNormal(rng[i]);
+				s0[i] = m_a1 * s0[i] + m_b0 * w;
+				out[i] = s0[i];
+			}
+			break;
+		}
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,147 @@
+/** @file
+	@brief Colored noise (pink, band-pass, Ornstein-Uhlenbeck) for the seats'
+	target angles, filtered from a fast normal generator.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformNoise_h_GUID_71F3C9B2_0E5A_4D86_B3F7_A4C2E8D61059
+#define INCLUDED_MotionPlatformNoise_h_GUID_71F3C9B2_0E5A_4D86_B3F7_A4C2E8D61059
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	inline boost::uint32_t xorshift32(boost::uint32_t x) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		return x;
+	}
+
+	/// @brief Starting state for a xorshift32 lane, which must not be zero.
+	inline boost::uint32_t seedLane(boost::uint32_t seed) { return seed ? seed : 1u; }
+
+	/// @brief Approximately normal sample with unit variance: the sum of the
+	/// four 16-bit halves of two xorshift32 draws (Irwin-Hall), bounded at
+	/// 3.5 sigma. Plain integer and float arithmetic, so loops over lanes
+	/// vectorize.
+	inline float fastNormal(boost::uint32_t &state) {
+		boost::uint32_t a = xorshift32(state);
+		boost::uint32_t b = xorshift32(a);
+		state = b;
+		float sum = static_cast<float>((a & 0xffff) + (a >> 16) + (b & 0xffff) + (b >> 16));
+		return (sum * (1.0f / 65536.0f) - 2.0f) * 1.7320508f;
+	}
+
+	/// @brief RBJ cookbook band-pass biquad with 0 dB peak gain, normalized
+	/// by a0 (so b1 is zero), run in transposed direct form II.
+	struct BandPass {
+		float b0, b2, a1, a2;
+
+		/// @brief Centered on @p frequency (Hz) with quality @p q, for
+		/// samples at @p rateHz.
+		static BandPass design(double frequency, double q, double rateHz);
+
+		/// @brief Filter one sample through the state @p z1, @p z2.
+		float step(float w, float &z1, float &z2) const {
+			const float y = b0 * w + z1;
+			z1 = z2 - a1 * y;
+			z2 = b2 * w - a2 * y;
+			return y;
+		}
+
+		/// @brief RMS of the response, from rest, to fastNormal() noise
+		/// drawn from a lane starting at @p state: divide by it to get a
+		/// given output RMS.
+		double whiteNoiseRms(boost::uint32_t state) const;
+	};
+
+	/// @brief Streams colored noise into the target angles of every seat,
+	/// in place of the simulation's uniform random angles.
+	///
+	/// The noise is given as one of
+	///
+	///     pink <rms degrees>
+	///     bandpass <center hz> <q> <rms degrees>
+	///     ou <rate 1/s> <rms degrees>
+	///
+	/// Each seat axis is an independent lane with its own generator and
+	/// filter state, stored one array per field and axis so every filter runs
+	/// as a straight loop over seats. White noise from fastNormal() is
+	/// filtered by
+	///  - pink: Paul Kellet's three-pole approximation of a -3 dB/octave slope
+	///    (at 1 kHz it covers roughly 0.4 to 100 Hz),
+	///  - bandpass: an RBJ band-pass biquad,
+	///  - ou: the exact discretization of an Ornstein-Uhlenbeck process, i.e.
+	///    a random walk pulled back to 0 at the given rate.
+	/// Pink and band-pass gains are calibrated when configured so the output
+	/// has the requested RMS. Angles are clamped to the simulation's range.
+	class NoiseGenerator : boost::noncopyable {
+	public:
+		/// @param rateHz tick rate the filters are designed for
+		NoiseGenerator(std::size_t seatCount, double rateHz, boost::uint32_t seed = 5489u);
+
+		/// @brief Select the noise described by @p spec and start it from rest.
+		/// @return false, with @p error set and the generator unchanged, if
+		/// @p spec is invalid.
+		bool configure(std::string const &spec, std::string &error);
+
+		/// @brief Draw the next target angles (degrees) of seats [begin, end),
+		/// clamped to [-maxAngle, maxAngle]. Disjoint ranges may be drawn
+		/// concurrently.
+		void generate(std::size_t begin, std::size_t end, float maxAngle, float *pitch, float *yaw, float *roll);
+
+	private:
+		enum Mode { PINK, BANDPASS, OU };
+
+		void reset();
+		float calibrate();
+		void filter(std::size_t lane, std::size_t count, float *out);
+
+		std::size_t m_seatCount;
+		double m_rateHz;
+		boost::uint32_t m_seed;
+		Mode m_mode;
+		float m_gain;
+		// biquad / Ornstein-Uhlenbeck coefficients
+		float m_b0, m_b2, m_a1, m_a2;
+
+		// per-lane state, lane = axis * seatCount + seat
+		std::vector<boost::uint32_t> m_rng;
+		std::vector<float> m_s0;
+		std::vector<float> m_s1;
+		std::vector<float> m_s2;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformNoise_h_GUID_71F3C9B2_0E5A_4D86_B3F7_A4C2E8D61059
@@ -0,0 +1,96 @@
+/** @file
+	@brief Implementation of locale independent number conversion.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformNumber.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+
+#if defined(_WIN32) || defined(__linux__)
+#include <locale.h>
+#elif defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
+namespace motionplatform {
+
+	namespace {
+
+		/*
+		 * Exact too but slower: for platforms without strtod_l, or when its
+		 * "C" locale could not be made. Out of range reads as infinity, the
+		 * way strtod's HUGE_VAL does, so parseDecimal refuses it.
+		 */
+		double classicStrtod(const char *text) {
+			std::istringstream is(text);
+			is.imbue(std::locale::classic());
+			double value = 0;
+			if (!(is >> value)) {
+				return std::numeric_limits<double>::infinity();
+			}
+			return value;
+		}
+
+#if defined(_WIN32)
+		/// made once, before main, and never freed; null if that failed
+		const _locale_t C_LOCALE = _create_locale(LC_NUMERIC, "C");
+
+		double strtodC(const char *text) {
+			return C_LOCALE ? _strtod_l(text, NULL, C_LOCALE) : classicStrtod(text);
+		}
+#elif defined(__linux__) || defined(__APPLE__)
+		/// made once, before main, and never freed; null if that failed
+		const locale_t C_LOCALE = newlocale(LC_NUMERIC_MASK, "C", static_cast<locale_t>(0));
+
+		double strtodC(const char *text) {
+			return C_LOCALE ? strtod_l(text, NULL, C_LOCALE) : classicStrtod(text);
+		}
+#else
+		double strtodC(const char *text) { return classicStrtod(text); }
+#endif
+
+	} // namespace
+
+	bool parseDecimal(const char *begin, const char *end, double &value) {
+		const std::size_t length = static_cast<std::size_t>(end - begin);
+		if (length > MAX_DECIMAL_LENGTH) {
+			return false;
+		}
+		char digits[MAX_DECIMAL_LENGTH + 1];
+		std::memcpy(digits, begin, length);
+		digits[length] = '\0';
+		value = strtodC(digits);
+		return std::isfinite(value);
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,51 @@
+/** @file
+	@brief Decimal number conversion that ignores the process locale.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformNumber_h_GUID_5D0B7E23_A914_4F6C_8E31_C27A9F4B06D8
+#define INCLUDED_MotionPlatformNumber_h_GUID_5D0B7E23_A914_4F6C_8E31_C27A9F4B06D8
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace motionplatform {
+
+	/// Longest number text parseDecimal() converts.
+	const std::size_t MAX_DECIMAL_LENGTH = 63;
+
+	/// @brief Convert the decimal number in [@p begin, @p end), e.g.
+	/// "-12.5e3", with '.' as the decimal point whatever locale the host
+	/// process set. The caller checks the syntax first: this only converts.
+	/// @return false if the text is longer than MAX_DECIMAL_LENGTH or the
+	/// value is out of the range of a double.
+	bool parseDecimal(const char *begin, const char *end, double &value);
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformNumber_h_GUID_5D0B7E23_A914_4F6C_8E31_C27A9F4B06D8
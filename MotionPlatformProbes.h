@@ -0,0 +1,60 @@
+/** @file
+	@brief Static (USDT / SystemTap SDT) tracepoints in the update path.
+
+	When built with <sys/sdt.h> each probe is a single NOP plus an ELF note
+	until a tracer attaches, e.g.
+
+	    bpftrace -e 'usdt:./MotionPlatformLoadGenerator:motionplatform:tick_start { @[arg0] = nsecs; }'
+
+	Without the header the probes compile away entirely.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformProbes_h_GUID_C48B0F6D_93A2_4D17_8E5B_16F7A2D9E0C3
+#define INCLUDED_MotionPlatformProbes_h_GUID_C48B0F6D_93A2_4D17_8E5B_16F7A2D9E0C3
+
+#ifdef MOTIONPLATFORM_HAVE_SDT
+#include <sys/sdt.h>
+
+/// A tick is about to be simulated: (tick number, seat count)
+#define MOTIONPLATFORM_PROBE_TICK_START(tick, seats) \
+	DTRACE_PROBE2(motionplatform, tick_start, tick, seats)
+/// Every seat of a tick has been generated: (tick number, seat count)
+#define MOTIONPLATFORM_PROBE_SAMPLE_GENERATED(tick, seats) \
+	DTRACE_PROBE2(motionplatform, sample_generated, tick, seats)
+/// A seat's pose went to OSVR: (seat, tick number)
+#define MOTIONPLATFORM_PROBE_POSE_SENT(seat, tick) \
+	DTRACE_PROBE2(motionplatform, pose_sent, seat, tick)
+/// A seat's analog channels went to OSVR: (seat, tick number)
+#define MOTIONPLATFORM_PROBE_ANALOG_SENT(seat, tick) \
+	DTRACE_PROBE2(motionplatform, analog_sent, seat, tick)
+
+#else
+
+#define MOTIONPLATFORM_PROBE_TICK_START(tick, seats) do {} while (0)
+#define MOTIONPLATFORM_PROBE_SAMPLE_GENERATED(tick, seats) do {} while (0)
+#define MOTIONPLATFORM_PROBE_POSE_SENT(seat, tick) do {} while (0)
+#define MOTIONPLATFORM_PROBE_ANALOG_SENT(seat, tick) do {} while (0)
+
+#endif
+
+#endif // INCLUDED_MotionPlatformProbes_h_GUID_C48B0F6D_93A2_4D17_8E5B_16F7A2D9E0C3
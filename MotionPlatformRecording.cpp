@@ -0,0 +1,258 @@
+/** @file
+	@brief Implementation of the recording writer.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformRecording.h"
+#include "MotionPlatformFile.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__unix__)
+#include <fcntl.h>
+#endif
+
+namespace motionplatform {
+
+	void captureTick(Simulation const &sim, boost::uint64_t timestampUsec,
+		std::vector<SampleRecord> &out) {
+		const std::size_t seats = sim.seatCount();
+		out.resize(seats);
+		double quat[4];
+		double actuators[Simulation::ACTUATOR_COUNT];
+		for (std::size_t seat = 0; seat < seats; ++seat) {
+			SampleRecord &rec = out[seat];
+			rec.timestampUsec = timestampUsec;
+			rec.tick = static_cast<boost::uint32_t>(sim.tick());
+			rec.seat = static_cast<boost::uint16_t>(seat);
+			rec.flags = 0;
+			sim.getOrientation(seat, quat);
+			sim.getActuators(seat, actuators);
+			for (int i = 0; i < 4; ++i) {
+				rec.orientation[i] = static_cast<float>(quat[i]);
+			}
+			for (std::size_t c = 0; c < Simulation::ACTUATOR_COUNT; ++c) {
+				rec.actuators[c] = static_cast<float>(actuators[c]);
+			}
+		}
+	}
+
+	void toEuler(const float quat[4], double &pitch, double &yaw, double &roll) {
+		const double x = quat[0], y = quat[1], z = quat[2], w = quat[3];
+		const double toDegrees = 180.0 / boost::math::constants::pi<double>();
+		roll = std::atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y)) * toDegrees;
+		pitch = std::asin(std::max(-1.0, std::min(1.0, 2 * (w * y - z * x)))) * toDegrees;
+		yaw = std::atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z)) * toDegrees;
+	}
+
+	RecordingWriter::RecordingWriter(std::string const &path, boost::uint32_t seatCount,
+		boost::uint32_t rateHz, boost::uint32_t blockTicks)
+		: m_file(std::fopen(path.c_str(), "wb")), m_blockTicks(blockTicks ? blockTicks : 1),
+		m_ticksInBlock(0), m_offset(sizeof(FileHeader)), m_lastTimestampUsec(0) {
+		if (!m_file) {
+			return;
+		}
+		FileHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+		header.version = RECORDING_VERSION;
+		header.recordSize = sizeof(SampleRecord);
+		header.seatCount = seatCount;
+		header.rateHz = rateHz;
+		header.blockTicks = m_blockTicks;
+		std::fwrite(&header, sizeof(header), 1, m_file);
+		m_block.reserve(static_cast<std::size_t>(seatCount) * m_blockTicks);
+	}
+
+	RecordingWriter::~RecordingWriter() {
+		if (m_file) {
+			flush();
+			writeIndex();
+			std::fclose(m_file);
+		}
+	}
+
+	void RecordingWriter::appendTick(std::vector<SampleRecord> const &samples) {
+		if (!m_file) {
+			return;
+		}
+		m_block.insert(m_block.end(), samples.begin(), samples.end());
+		if (++m_ticksInBlock >= m_blockTicks) {
+			flush();
+		}
+	}
+
+	void RecordingWriter::flush() {
+		if (!m_file || m_block.empty()) {
+			return;
+		}
+		BlockHeader header;
+		header.firstTimestampUsec = m_block.front().timestampUsec;
+		header.sampleCount = static_cast<boost::uint32_t>(m_block.size());
+		header.kind = SAMPLE_BLOCK;
+		std::fwrite(&header, sizeof(header), 1, m_file);
+		std::fwrite(&m_block[0], sizeof(SampleRecord), m_block.size(), m_file);
+		IndexEntry entry = { header.firstTimestampUsec, m_offset };
+		m_index.push_back(entry);
+		m_offset += sizeof(header) + m_block.size() * sizeof(SampleRecord);
+		m_lastTimestampUsec = m_block.back().timestampUsec;
+		m_block.clear();
+		m_ticksInBlock = 0;
+	}
+
+	/*
+	 * Append the index block and trailer after the last sample block
+	 */
+	void RecordingWriter::writeIndex() {
+		BlockHeader header = { 0, 0, INDEX_BLOCK };
+		std::fwrite(&header, sizeof(header), 1, m_file);
+		if (!m_index.empty()) {
+			std::fwrite(&m_index[0], sizeof(IndexEntry), m_index.size(), m_file);
+		}
+		IndexTrailer trailer;
+		std::memset(&trailer, 0, sizeof(trailer));
+		trailer.indexOffset = m_offset;
+		trailer.lastTimestampUsec = m_lastTimestampUsec;
+		trailer.entryCount = static_cast<boost::uint32_t>(m_index.size());
+		std::memcpy(trailer.magic, INDEX_MAGIC, sizeof(trailer.magic));
+		std::fwrite(&trailer, sizeof(trailer), 1, m_file);
+	}
+
+	RecordingReader::RecordingReader(std::string const &path)
+		: m_file(std::fopen(path.c_str(), "rb")), m_size(0) {
+		std::memset(&m_header, 0, sizeof(m_header));
+		if (!m_file) {
+			return;
+		}
+		if (seekFile(m_file, 0, SEEK_END)) {
+			const boost::int64_t size = tellFile(m_file);
+			m_size = size > 0 ? static_cast<boost::uint64_t>(size) : 0;
+		}
+		std::rewind(m_file);
+		if (std::fread(&m_header, sizeof(m_header), 1, m_file) != 1 ||
+			std::memcmp(m_header.magic, RECORDING_MAGIC, sizeof(m_header.magic)) != 0 ||
+			m_header.version < 1 || m_header.version > RECORDING_VERSION ||
+			m_header.recordSize != sizeof(SampleRecord)) {
+			std::fclose(m_file);
+			m_file = NULL;
+		}
+	}
+
+	RecordingReader::~RecordingReader() {
+		if (m_file) {
+			std::fclose(m_file);
+		}
+	}
+
+	bool RecordingReader::readBlock(std::vector<SampleRecord> &samples) {
+		BlockHeader header;
+		if (!m_file || std::fread(&header, sizeof(header), 1, m_file) != 1 || header.kind != SAMPLE_BLOCK) {
+			return false;
+		}
+		/// a damaged count must not size the buffer past what the file holds
+		const boost::int64_t position = tellFile(m_file);
+		if (position < 0 || header.sampleCount > (m_size - static_cast<boost::uint64_t>(position)) / sizeof(SampleRecord)) {
+			return false;
+		}
+		samples.resize(header.sampleCount);
+		return header.sampleCount == 0 ||
+			std::fread(&samples[0], sizeof(SampleRecord), samples.size(), m_file) == samples.size();
+	}
+
+	bool RecordingReader::readBlockAt(boost::uint64_t offset, std::vector<SampleRecord> &samples) {
+		return m_file && offset <= m_size && seekFile(m_file, static_cast<boost::int64_t>(offset), SEEK_SET) &&
+			readBlock(samples);
+	}
+
+	void RecordingReader::willNeed(boost::uint64_t offset, boost::uint64_t length) const {
+#if defined(__unix__) && defined(POSIX_FADV_WILLNEED)
+		if (m_file) {
+			posix_fadvise(fileno(m_file), static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_WILLNEED);
+		}
+#else
+		(void)offset;
+		(void)length;
+#endif
+	}
+
+	bool RecordingReader::readIndex(std::vector<IndexEntry> &index, boost::uint64_t &lastTimestampUsec) {
+		index.clear();
+		if (!m_file) {
+			return false;
+		}
+		if (readTrailer(index, lastTimestampUsec)) {
+			return !index.empty();
+		}
+		/// no usable index: hop from block header to block header
+		boost::uint64_t offset = sizeof(FileHeader);
+		BlockHeader header;
+		std::vector<SampleRecord> last;
+		while (offset <= m_size && seekFile(m_file, static_cast<boost::int64_t>(offset), SEEK_SET) &&
+			std::fread(&header, sizeof(header), 1, m_file) == 1 && header.kind == SAMPLE_BLOCK) {
+			IndexEntry entry = { header.firstTimestampUsec, offset };
+			index.push_back(entry);
+			offset += sizeof(header) + static_cast<boost::uint64_t>(header.sampleCount) * sizeof(SampleRecord);
+		}
+		/// a truncated last block is dropped
+		while (!index.empty() && !(readBlockAt(index.back().offset, last) && !last.empty())) {
+			index.pop_back();
+		}
+		if (index.empty()) {
+			return false;
+		}
+		lastTimestampUsec = last.back().timestampUsec;
+		return true;
+	}
+
+	/*
+	 * Load the index a writer stored at the end of the file, if there is one
+	 */
+	bool RecordingReader::readTrailer(std::vector<IndexEntry> &index, boost::uint64_t &lastTimestampUsec) {
+		IndexTrailer trailer;
+		BlockHeader header;
+		if (m_header.version < 2 ||
+			!seekFile(m_file, -static_cast<boost::int64_t>(sizeof(trailer)), SEEK_END) ||
+			std::fread(&trailer, sizeof(trailer), 1, m_file) != 1 ||
+			std::memcmp(trailer.magic, INDEX_MAGIC, sizeof(trailer.magic)) != 0 ||
+			trailer.indexOffset > m_size ||
+			!seekFile(m_file, static_cast<boost::int64_t>(trailer.indexOffset), SEEK_SET) ||
+			std::fread(&header, sizeof(header), 1, m_file) != 1 || header.kind != INDEX_BLOCK ||
+			trailer.entryCount > (m_size - trailer.indexOffset) / sizeof(IndexEntry)) {
+			return false;
+		}
+		index.resize(trailer.entryCount);
+		if (!index.empty() && std::fread(&index[0], sizeof(IndexEntry), index.size(), m_file) != index.size()) {
+			index.clear();
+			return false;
+		}
+		lastTimestampUsec = trailer.lastTimestampUsec;
+		return true;
+	}
+
+} // namespace motionplatform
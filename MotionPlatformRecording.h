@@ -0,0 +1,184 @@
+/** @file
+	@brief Sample record and block-structured recording file format shared by
+	the headless tools.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformRecording_h_GUID_2E7A9D43_B1C6_4F08_8D3E_A59C0B7F6124
+#define INCLUDED_MotionPlatformRecording_h_GUID_2E7A9D43_B1C6_4F08_8D3E_A59C0B7F6124
+
+// Internal Includes
+#include "MotionPlatformSimulation.h"
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief One published sample of one seat, as written by the tools.
+	///
+	/// Plain data in host byte order; recordings are meant to be read back
+	/// on the machine (or at least the architecture) that made them.
+	struct SampleRecord {
+		boost::uint64_t timestampUsec;
+		boost::uint32_t tick;
+		boost::uint16_t seat;
+		boost::uint16_t flags;
+		float orientation[4]; ///< x, y, z, w
+		float actuators[Simulation::ACTUATOR_COUNT];
+	};
+
+	/// @brief Recording file layout:
+	///
+	/// - one FileHeader
+	/// - any number of blocks, each a BlockHeader followed by
+	///   BlockHeader::sampleCount SampleRecord entries
+	/// - (version 2) the block index: a BlockHeader of kind INDEX_BLOCK,
+	///   IndexTrailer::entryCount IndexEntry values and an IndexTrailer
+	///
+	/// Blocks never split a tick, so every block starts at a tick boundary.
+	/// A writer that did not get to close the file leaves no index; readers
+	/// then rebuild it from the block headers.
+	struct FileHeader {
+		char magic[8];
+		boost::uint32_t version;
+		boost::uint32_t recordSize;
+		boost::uint32_t seatCount;
+		boost::uint32_t rateHz;
+		boost::uint32_t blockTicks;
+		boost::uint32_t reserved;
+	};
+
+	struct BlockHeader {
+		boost::uint64_t firstTimestampUsec;
+		boost::uint32_t sampleCount;
+		boost::uint32_t kind; ///< SAMPLE_BLOCK or INDEX_BLOCK
+	};
+
+	/// @brief One entry of the block index: where each block starts.
+	struct IndexEntry {
+		boost::uint64_t firstTimestampUsec;
+		boost::uint64_t offset; ///< of the BlockHeader, from the file start
+	};
+
+	/// @brief Last bytes of an indexed recording.
+	struct IndexTrailer {
+		boost::uint64_t indexOffset; ///< of the index BlockHeader
+		boost::uint64_t lastTimestampUsec;
+		boost::uint32_t entryCount;
+		boost::uint32_t reserved;
+		char magic[8];
+	};
+
+	static const char RECORDING_MAGIC[8] = { 'M', 'P', 'S', 'R', 'E', 'C', '\0', '\0' };
+	static const char INDEX_MAGIC[8] = { 'M', 'P', 'S', 'I', 'D', 'X', '\0', '\0' };
+	/// version 1 files are read too; they have no index
+	static const boost::uint32_t RECORDING_VERSION = 2;
+	static const boost::uint32_t SAMPLE_BLOCK = 0;
+	static const boost::uint32_t INDEX_BLOCK = 1;
+
+	/// @brief Copy every seat of the current simulation tick into @p out.
+	void captureTick(Simulation const &sim, boost::uint64_t timestampUsec,
+		std::vector<SampleRecord> &out);
+
+	/// @brief Euler angles (degrees) of an orientation built as in
+	/// Simulation::convert: roll about x, pitch about y, yaw about z.
+	void toEuler(const float quat[4], double &pitch, double &yaw, double &roll);
+
+	/// @brief Appends ticks to a recording file, one block per
+	/// @p blockTicks ticks, and writes the block index when destroyed.
+	class RecordingWriter : boost::noncopyable {
+	public:
+		RecordingWriter(std::string const &path, boost::uint32_t seatCount,
+			boost::uint32_t rateHz, boost::uint32_t blockTicks = 256);
+		~RecordingWriter();
+
+		bool isOpen() const { return m_file != NULL; }
+
+		/// @brief Buffer one tick worth of samples, flushing full blocks.
+		void appendTick(std::vector<SampleRecord> const &samples);
+
+		/// @brief Write out the partially filled block, if any.
+		void flush();
+
+	private:
+		void writeIndex();
+
+		std::FILE *m_file;
+		boost::uint32_t m_blockTicks;
+		boost::uint32_t m_ticksInBlock;
+		std::vector<SampleRecord> m_block;
+		/// where the next block goes
+		boost::uint64_t m_offset;
+		boost::uint64_t m_lastTimestampUsec;
+		std::vector<IndexEntry> m_index;
+	};
+
+	/// @brief Reads a recording back one block at a time, so only one block
+	/// is ever held in memory.
+	class RecordingReader : boost::noncopyable {
+	public:
+		explicit RecordingReader(std::string const &path);
+		~RecordingReader();
+
+		/// @brief Whether the file opened and has a header this build can read.
+		bool isOpen() const { return m_file != NULL; }
+
+		FileHeader const &header() const { return m_header; }
+
+		/// @brief Replace @p samples with the next block.
+		/// @return false at the end of the samples or at a truncated block.
+		bool readBlock(std::vector<SampleRecord> &samples);
+
+		/// @brief Replace @p samples with the block whose header is at
+		/// @p offset, and continue reading after it.
+		bool readBlockAt(boost::uint64_t offset, std::vector<SampleRecord> &samples);
+
+		/// @brief Hint that bytes [offset, offset + length) will be read soon
+		/// (posix_fadvise WILLNEED, a no-op where that is not available); a
+		/// length of 0 reaches to the end of the file.
+		void willNeed(boost::uint64_t offset, boost::uint64_t length) const;
+
+		/// @brief Fill @p index with every block and return the timestamp of
+		/// the last sample. Reads the stored index, or walks the block headers
+		/// of a file that has none. Leaves the read position undefined.
+		/// @return false if the recording has no samples.
+		bool readIndex(std::vector<IndexEntry> &index, boost::uint64_t &lastTimestampUsec);
+
+	private:
+		bool readTrailer(std::vector<IndexEntry> &index, boost::uint64_t &lastTimestampUsec);
+
+		std::FILE *m_file;
+		FileHeader m_header;
+		/// counts read from the file are checked against this before use
+		boost::uint64_t m_size;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformRecording_h_GUID_2E7A9D43_B1C6_4F08_8D3E_A59C0B7F6124
@@ -0,0 +1,534 @@
+/** @file
+	@brief Implementation of recording playback.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformReplay.h"
+
+// Library/third-party includes
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace motionplatform {
+
+	namespace {
+
+		const std::size_t NO_BLOCK = static_cast<std::size_t>(-1);
+		const boost::uint64_t NO_TICK = static_cast<boost::uint64_t>(-1);
+
+		bool startsBefore(boost::uint64_t usec, IndexEntry const &entry) {
+			return usec < entry.firstTimestampUsec;
+		}
+
+		bool recordedBefore(boost::uint64_t usec, SampleRecord const &record) {
+			return usec < record.timestampUsec;
+		}
+
+	} // namespace
+
+	/// @brief One recording: its index, the decoded block holding the tick
+	/// it shows, and its read-ahead thread.
+	class ReplayPlayer::Stream : boost::noncopyable {
+	public:
+		Stream(std::string const &path, std::size_t readAhead);
+		~Stream();
+
+		bool isOpen() const { return !m_index.empty(); }
+		boost::uint64_t firstUsec() const { return m_index.front().firstTimestampUsec; }
+		boost::uint64_t lastUsec() const { return m_lastUsec; }
+
+		/// @brief When the tick after the shown one was recorded, NO_TICK at
+		/// the end.
+		boost::uint64_t nextUsec() const;
+
+		/// @brief Show the last tick recorded at or before @p usec (none if
+		/// the stream starts later), updating its seats in @p frame.
+		void locate(boost::uint64_t usec, std::vector<const SampleRecord *> &frame);
+		/// @brief Like locate() for a playhead that moved forward.
+		void catchUp(boost::uint64_t usec, std::vector<const SampleRecord *> &frame);
+
+		/// @brief Keep the block holding @p usec decoded, NO_TICK for none.
+		void setLoopStart(boost::uint64_t usec);
+
+		boost::uint64_t prefetched() const { return m_prefetched.load(boost::memory_order_relaxed); }
+		boost::uint64_t misses() const { return m_misses.load(boost::memory_order_relaxed); }
+
+	private:
+		/// A decoded block held by the read-ahead thread
+		struct Slot {
+			std::vector<SampleRecord> samples;
+			std::size_t block; ///< NO_BLOCK when free
+			bool ready;
+		};
+
+		std::size_t blockAt(boost::uint64_t usec) const;
+		bool load(std::size_t block);
+		bool takePrefetched(std::size_t block);
+		void selectTick(std::size_t first);
+		void map(std::vector<const SampleRecord *> &frame) const;
+		void unmap(std::vector<const SampleRecord *> &frame) const;
+		void readAheadMain();
+		bool nextToFetch(std::size_t &block, std::size_t &slot) const;
+
+		RecordingReader m_reader;
+		std::vector<IndexEntry> m_index;
+		boost::uint64_t m_lastUsec;
+
+		/// the decoded block, and the shown tick's records within it (an
+		/// empty range before the stream starts)
+		std::vector<SampleRecord> m_block;
+		/// decode target, swapped in on success so a failed read changes nothing
+		std::vector<SampleRecord> m_spare;
+		std::size_t m_blockIndex;
+		std::size_t m_tickBegin;
+		std::size_t m_tickEnd;
+
+		// read-ahead; the thread has its own reader so neither waits on the
+		// other's file position
+		std::size_t m_readAhead;
+		boost::scoped_ptr<RecordingReader> m_aheadReader;
+		/// guards the slots and the two block numbers below
+		boost::mutex m_mutex;
+		boost::condition_variable m_wake;
+		std::vector<Slot> m_slots;
+		/// first block of the window
+		std::size_t m_wanted;
+		/// block the loop region starts in, or NO_BLOCK
+		std::size_t m_loopBlock;
+		bool m_stopping;
+		boost::atomic<boost::uint64_t> m_prefetched;
+		boost::atomic<boost::uint64_t> m_misses;
+		/// declared last: started once everything above is set up
+		boost::thread m_thread;
+	};
+
+	ReplayPlayer::Stream::Stream(std::string const &path, std::size_t readAhead)
+		: m_reader(path), m_lastUsec(0), m_blockIndex(0), m_tickBegin(0), m_tickEnd(0),
+		m_readAhead(0), m_wanted(1), m_loopBlock(NO_BLOCK), m_stopping(false), m_prefetched(0), m_misses(0) {
+		if (!m_reader.readIndex(m_index, m_lastUsec)) {
+			m_index.clear();
+			return;
+		}
+		if (!load(0)) {
+			m_index.clear();
+			return;
+		}
+		/// the first block is always read here, not missed
+		m_misses.store(0, boost::memory_order_relaxed);
+		if (readAhead > 0) {
+			m_aheadReader.reset(new RecordingReader(path));
+			if (m_aheadReader->isOpen()) {
+				Slot empty = { std::vector<SampleRecord>(), NO_BLOCK, false };
+				m_slots.assign(readAhead + 1, empty);
+				m_readAhead = readAhead;
+				m_thread = boost::thread(boost::bind(&Stream::readAheadMain, this));
+			}
+		}
+	}
+
+	ReplayPlayer::Stream::~Stream() {
+		if (m_thread.joinable()) {
+			{
+				boost::lock_guard<boost::mutex> lock(m_mutex);
+				m_stopping = true;
+				m_wake.notify_all();
+			}
+			m_thread.join();
+		}
+	}
+
+	boost::uint64_t ReplayPlayer::Stream::nextUsec() const {
+		if (m_tickEnd < m_block.size()) {
+			return m_block[m_tickEnd].timestampUsec;
+		}
+		/// ticks never straddle blocks
+		return m_blockIndex + 1 < m_index.size() ? m_index[m_blockIndex + 1].firstTimestampUsec : NO_TICK;
+	}
+
+	/*
+	 * A binary search of the block index, at most one block decode, and a
+	 * binary search of that block
+	 */
+	void ReplayPlayer::Stream::locate(boost::uint64_t usec, std::vector<const SampleRecord *> &frame) {
+		unmap(frame);
+		const std::size_t block = blockAt(usec);
+		if (block == m_blockIndex || load(block)) {
+			std::vector<SampleRecord>::const_iterator record =
+				std::upper_bound(m_block.begin(), m_block.end(), usec, recordedBefore);
+			if (record == m_block.begin()) {
+				/// not started yet
+				m_tickBegin = m_tickEnd = 0;
+				return;
+			}
+			std::size_t first = static_cast<std::size_t>(record - m_block.begin()) - 1;
+			while (first > 0 && m_block[first - 1].tick == m_block[first].tick) {
+				--first;
+			}
+			selectTick(first);
+		}
+		map(frame);
+	}
+
+	void ReplayPlayer::Stream::catchUp(boost::uint64_t usec, std::vector<const SampleRecord *> &frame) {
+		if (m_blockIndex + 1 < m_index.size() && m_index[m_blockIndex + 1].firstTimestampUsec <= usec) {
+			/// left the decoded block: go through the index
+			locate(usec, frame);
+			return;
+		}
+		/// usually a step of one tick within the decoded block
+		std::size_t first = m_tickBegin;
+		std::size_t next = m_tickEnd;
+		bool moved = false;
+		while (next < m_block.size() && m_block[next].timestampUsec <= usec) {
+			first = next;
+			moved = true;
+			while (next < m_block.size() && m_block[next].tick == m_block[first].tick) {
+				++next;
+			}
+		}
+		if (moved) {
+			unmap(frame);
+			selectTick(first);
+			map(frame);
+		}
+	}
+
+	void ReplayPlayer::Stream::setLoopStart(boost::uint64_t usec) {
+		if (m_readAhead) {
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_loopBlock = usec == NO_TICK ? NO_BLOCK : blockAt(usec);
+			m_wake.notify_all();
+		}
+	}
+
+	/*
+	 * Last block starting at or before @p usec
+	 */
+	std::size_t ReplayPlayer::Stream::blockAt(boost::uint64_t usec) const {
+		std::vector<IndexEntry>::const_iterator entry =
+			std::upper_bound(m_index.begin(), m_index.end(), usec, startsBefore);
+		return entry == m_index.begin() ? 0 : static_cast<std::size_t>(entry - m_index.begin()) - 1;
+	}
+
+	/*
+	 * Make block @p block current, from the read-ahead window if it is
+	 * there; on failure the previous block stays current
+	 */
+	bool ReplayPlayer::Stream::load(std::size_t block) {
+		if (takePrefetched(block)) {
+			m_prefetched.fetch_add(1, boost::memory_order_relaxed);
+		} else {
+			if (!m_reader.readBlockAt(m_index[block].offset, m_spare) || m_spare.empty()) {
+				return false;
+			}
+			m_block.swap(m_spare);
+			m_misses.fetch_add(1, boost::memory_order_relaxed);
+		}
+		m_blockIndex = block;
+		m_tickBegin = m_tickEnd = 0;
+		if (m_readAhead) {
+			boost::lock_guard<boost::mutex> lock(m_mutex);
+			m_wanted = block + 1;
+			m_wake.notify_all();
+		}
+		return true;
+	}
+
+	/*
+	 * Swap in @p block if the read-ahead has it decoded; the storage of the
+	 * block being left goes back to the slot for reuse
+	 */
+	bool ReplayPlayer::Stream::takePrefetched(std::size_t block) {
+		if (!m_readAhead) {
+			return false;
+		}
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+		for (std::size_t i = 0; i < m_slots.size(); ++i) {
+			Slot &slot = m_slots[i];
+			if (slot.ready && slot.block == block) {
+				m_block.swap(slot.samples);
+				slot.block = NO_BLOCK;
+				slot.ready = false;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/*
+	 * Make the tick starting at record @p first current
+	 */
+	void ReplayPlayer::Stream::selectTick(std::size_t first) {
+		m_tickBegin = first;
+		m_tickEnd = first;
+		while (m_tickEnd < m_block.size() && m_block[m_tickEnd].tick == m_block[first].tick) {
+			++m_tickEnd;
+		}
+	}
+
+	void ReplayPlayer::Stream::map(std::vector<const SampleRecord *> &frame) const {
+		for (std::size_t i = m_tickBegin; i < m_tickEnd; ++i) {
+			if (m_block[i].seat < frame.size()) {
+				frame[m_block[i].seat] = &m_block[i];
+			}
+		}
+	}
+
+	/*
+	 * Clear the seats of the shown tick, unless another stream has taken
+	 * them since; must run before the block is swapped out
+	 */
+	void ReplayPlayer::Stream::unmap(std::vector<const SampleRecord *> &frame) const {
+		for (std::size_t i = m_tickBegin; i < m_tickEnd; ++i) {
+			if (m_block[i].seat < frame.size() && frame[m_block[i].seat] == &m_block[i]) {
+				frame[m_block[i].seat] = NULL;
+			}
+		}
+	}
+
+	/*
+	 * Keep the window decoded, reading with the lock released. A read error
+	 * ends the read-ahead; the calling thread then reads (and reports) it.
+	 */
+	void ReplayPlayer::Stream::readAheadMain() {
+		std::vector<SampleRecord> samples;
+		boost::unique_lock<boost::mutex> lock(m_mutex);
+		while (!m_stopping) {
+			std::size_t block, slot;
+			if (!nextToFetch(block, slot)) {
+				m_wake.wait(lock);
+				continue;
+			}
+			m_slots[slot].block = block;
+			m_slots[slot].ready = false;
+			const std::size_t hintBegin = m_wanted + m_readAhead;
+			lock.unlock();
+			if (hintBegin < m_index.size()) {
+				/// have the kernel fetch the next window while this one decodes
+				const std::size_t hintEnd = std::min(hintBegin + m_readAhead, m_index.size());
+				const boost::uint64_t offset = m_index[hintBegin].offset;
+				m_aheadReader->willNeed(offset, hintEnd < m_index.size() ? m_index[hintEnd].offset - offset : 0);
+			}
+			const bool ok = m_aheadReader->readBlockAt(m_index[block].offset, samples) && !samples.empty();
+			lock.lock();
+			Slot &target = m_slots[slot];
+			if (!ok) {
+				target.block = NO_BLOCK;
+				return;
+			}
+			target.samples.swap(samples);
+			target.ready = true;
+		}
+	}
+
+	/*
+	 * First block of the window (or the loop start) that no slot holds, and
+	 * a slot that is free or holds a block that fell out of the window;
+	 * called with the lock held
+	 */
+	bool ReplayPlayer::Stream::nextToFetch(std::size_t &block, std::size_t &slot) const {
+		for (std::size_t i = 0; i <= m_readAhead; ++i) {
+			block = i < m_readAhead ? m_wanted + i : m_loopBlock;
+			if (block >= m_index.size()) {
+				continue;
+			}
+			bool held = false;
+			for (std::size_t s = 0; s < m_slots.size() && !held; ++s) {
+				held = m_slots[s].block == block;
+			}
+			if (held) {
+				continue;
+			}
+			for (slot = 0; slot < m_slots.size(); ++slot) {
+				const std::size_t other = m_slots[slot].block;
+				const bool wanted = (other >= m_wanted && other < m_wanted + m_readAhead) || other == m_loopBlock;
+				if (other == NO_BLOCK || (m_slots[slot].ready && !wanted)) {
+					return true;
+				}
+			}
+			return false;
+		}
+		return false;
+	}
+
+	namespace {
+
+		/// heap order: earliest first, ties by stream so merging is repeatable
+		struct DueLater {
+			template <typename Due> bool operator()(Due const &a, Due const &b) const {
+				return a.usec > b.usec || (a.usec == b.usec && a.stream > b.stream);
+			}
+		};
+
+	} // namespace
+
+	const std::size_t ReplayPlayer::MAX_READ_AHEAD;
+
+	ReplayPlayer::ReplayPlayer(std::vector<std::string> const &paths, std::size_t seatCount, std::size_t readAhead)
+		: m_firstUsec(NO_TICK), m_lastUsec(0), m_position(0), m_speed(1), m_loopBegin(0), m_loopEnd(0),
+		m_frame(seatCount, static_cast<const SampleRecord *>(NULL)) {
+		for (std::size_t i = 0; i < paths.size(); ++i) {
+			StreamPtr stream(new Stream(paths[i], std::min(readAhead, MAX_READ_AHEAD)));
+			if (!stream->isOpen()) {
+				m_streams.clear();
+				return;
+			}
+			m_firstUsec = std::min(m_firstUsec, stream->firstUsec());
+			m_lastUsec = std::max(m_lastUsec, stream->lastUsec());
+			m_streams.push_back(stream);
+		}
+		if (!m_streams.empty()) {
+			locate(m_firstUsec);
+		}
+	}
+
+	/// joins every stream's read-ahead thread
+	ReplayPlayer::~ReplayPlayer() {}
+
+	double ReplayPlayer::duration() const { return isOpen() ? (m_lastUsec - m_firstUsec) * 1.0e-6 : 0.0; }
+
+	double ReplayPlayer::position() const { return m_position * 1.0e-6; }
+
+	void ReplayPlayer::seek(double seconds) {
+		if (!isOpen()) {
+			return;
+		}
+		const double length = static_cast<double>(m_lastUsec - m_firstUsec);
+		m_position = std::isfinite(seconds) ? std::max(0.0, std::min(seconds * 1.0e6, length)) : 0.0;
+		locate(playheadUsec());
+	}
+
+	void ReplayPlayer::setLoop(double begin, double end) {
+		/// kept within the recording, so the playhead they set converts to
+		/// microseconds exactly
+		const double length = isOpen() ? static_cast<double>(m_lastUsec - m_firstUsec) : 0.0;
+		if (std::isfinite(begin) && std::isfinite(end)) {
+			m_loopBegin = std::max(0.0, std::min(begin * 1.0e6, length));
+			m_loopEnd = std::max(0.0, std::min(end * 1.0e6, length));
+		} else {
+			m_loopBegin = 0;
+			m_loopEnd = 0;
+		}
+		const boost::uint64_t start =
+			m_loopEnd > m_loopBegin ? m_firstUsec + static_cast<boost::uint64_t>(m_loopBegin) : NO_TICK;
+		for (std::size_t i = 0; i < m_streams.size(); ++i) {
+			m_streams[i]->setLoopStart(start);
+		}
+	}
+
+	void ReplayPlayer::writeTargets(std::size_t begin, std::size_t end, float *pitch, float *yaw, float *roll) const {
+		for (std::size_t i = begin; i < end; ++i) {
+			if (const SampleRecord *record = m_frame[i]) {
+				double p, y, r;
+				toEuler(record->orientation, p, y, r);
+				pitch[i] = static_cast<float>(p);
+				yaw[i] = static_cast<float>(y);
+				roll[i] = static_cast<float>(r);
+			}
+		}
+	}
+
+	void ReplayPlayer::writeActuators(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount) const {
+		for (std::size_t c = 0; c < Simulation::ACTUATOR_COUNT; ++c) {
+			float *channel = actuators + c * seatCount;
+			for (std::size_t i = begin; i < end; ++i) {
+				if (const SampleRecord *record = m_frame[i]) {
+					channel[i] = record->actuators[c];
+				}
+			}
+		}
+	}
+
+	void ReplayPlayer::advance(double dt) {
+		if (!isOpen()) {
+			return;
+		}
+		m_position += dt * m_speed * 1.0e6;
+		if (m_loopEnd > m_loopBegin && m_position >= m_loopEnd) {
+			m_position = m_loopBegin + std::fmod(m_position - m_loopBegin, m_loopEnd - m_loopBegin);
+			locate(playheadUsec());
+			return;
+		}
+		m_position = std::min(m_position, static_cast<double>(m_lastUsec - m_firstUsec));
+		const boost::uint64_t usec = playheadUsec();
+		/// k-way merge: catch up the streams whose next tick is due, earliest
+		/// first; the rest are not touched
+		while (!m_heap.empty() && m_heap.front().usec <= usec) {
+			std::pop_heap(m_heap.begin(), m_heap.end(), DueLater());
+			Due &due = m_heap.back();
+			m_streams[due.stream]->catchUp(usec, m_frame);
+			due.usec = m_streams[due.stream]->nextUsec();
+			if (due.usec == NO_TICK) {
+				m_heap.pop_back();
+				continue;
+			}
+			/// a block that failed to read is retried next tick
+			due.usec = std::max(due.usec, usec + 1);
+			std::push_heap(m_heap.begin(), m_heap.end(), DueLater());
+		}
+	}
+
+	boost::uint64_t ReplayPlayer::prefetched() const {
+		boost::uint64_t total = 0;
+		for (std::size_t i = 0; i < m_streams.size(); ++i) {
+			total += m_streams[i]->prefetched();
+		}
+		return total;
+	}
+
+	boost::uint64_t ReplayPlayer::misses() const {
+		boost::uint64_t total = 0;
+		for (std::size_t i = 0; i < m_streams.size(); ++i) {
+			total += m_streams[i]->misses();
+		}
+		return total;
+	}
+
+	/*
+	 * Put every stream at @p usec and rebuild the heap from scratch
+	 */
+	void ReplayPlayer::locate(boost::uint64_t usec) {
+		m_heap.clear();
+		for (std::size_t i = 0; i < m_streams.size(); ++i) {
+			m_streams[i]->locate(usec, m_frame);
+			Due due = { m_streams[i]->nextUsec(), i };
+			if (due.usec != NO_TICK) {
+				m_heap.push_back(due);
+			}
+		}
+		std::make_heap(m_heap.begin(), m_heap.end(), DueLater());
+	}
+
+	boost::uint64_t ReplayPlayer::playheadUsec() const {
+		return m_firstUsec + static_cast<boost::uint64_t>(m_position);
+	}
+
+} // namespace motionplatform
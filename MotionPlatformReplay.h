@@ -0,0 +1,154 @@
+/** @file
+	@brief Plays recordings back into the simulation, merged by timestamp,
+	with seeking, loop regions and speed changes.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformReplay_h_GUID_E17B6C02_94A3_4D5E_B8F1_2C6A09D7E543
+#define INCLUDED_MotionPlatformReplay_h_GUID_E17B6C02_94A3_4D5E_B8F1_2C6A09D7E543
+
+// Internal Includes
+#include "MotionPlatformRecording.h"
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief Replays a recorded ride: every recorded seat's pose becomes its
+	/// target angles and its actuator channels are restored as recorded.
+	/// Seats the recording does not have keep their own motion.
+	///
+	/// Playback follows the recorded timestamps. The playhead moves by
+	/// dt * speed every tick and the tick shown is the last one recorded at or
+	/// before it. Past the end of the recording the last tick is held; inside
+	/// a loop region the playhead wraps back to the region's start.
+	///
+	/// A ride may be split over several recordings (streams), e.g. one per
+	/// seat or per device, that were recorded against the same clock. They
+	/// share the playhead and are merged by timestamp: a small heap keyed on
+	/// each stream's next tick decides which streams are due, so a tick costs
+	/// O(log k) per stream that moves, not a scan of all k. A stream is not
+	/// shown before its first sample. The merged set of poses is only
+	/// changed in advance(), between updates, so every update sees one
+	/// coherent instant of all streams. Seats recorded in more than one
+	/// stream show the stream that moved last.
+	///
+	/// Only one block per stream is decoded at a time. Jumps (seeks, loop
+	/// wraps, or a speed high enough to skip a block) binary-search the block
+	/// index and decode the one block they land in, so their cost does not
+	/// depend on the length of the recording or the distance jumped.
+	///
+	/// With a read-ahead window, each stream has a thread of its own that
+	/// keeps the next blocks (and the start of the loop region) decoded, and
+	/// asks the kernel to start reading the blocks past those. Moving on to a
+	/// block it has ready is a swap under a short lock, so slow storage does
+	/// not stall the tick. Blocks it did not have ready (typically after a
+	/// seek) are read directly and counted in misses().
+	class ReplayPlayer : boost::noncopyable {
+	public:
+		/// Most blocks a stream keeps decoded ahead; more are capped.
+		static const std::size_t MAX_READ_AHEAD = 64;
+
+		/// @param paths the recordings to merge, at least one
+		/// @param readAhead blocks to keep decoded ahead of the playhead, 0
+		/// to read every block when it is reached
+		ReplayPlayer(std::vector<std::string> const &paths, std::size_t seatCount, std::size_t readAhead = 0);
+		~ReplayPlayer();
+
+		/// @brief Whether every recording opened and has samples.
+		bool isOpen() const { return !m_streams.empty(); }
+
+		/// Number of recordings merged.
+		std::size_t streamCount() const { return m_streams.size(); }
+
+		/// Seconds from the first to the last recorded sample of any stream.
+		double duration() const;
+		/// Seconds from the first recorded sample to the playhead.
+		double position() const;
+
+		/// @brief Move the playhead to @p seconds into the recording,
+		/// clamped to its duration (a non-finite time goes to the start). The
+		/// setters must not be called during an update.
+		void seek(double seconds);
+		/// @brief Wrap from @p end back to @p begin (seconds), both clamped to
+		/// the duration; disabled when @p end is not after @p begin or either
+		/// is not finite.
+		void setLoop(double begin, double end);
+		/// @brief Playback rate relative to the recording; 0 pauses.
+		void setSpeed(double speed) { m_speed = speed; }
+
+		/// @brief Set the target angles (degrees) of recorded seats within
+		/// [begin, end) to the current tick's poses. Disjoint ranges may be
+		/// written concurrently.
+		void writeTargets(std::size_t begin, std::size_t end, float *pitch, float *yaw, float *roll) const;
+
+		/// @brief Restore the current tick's actuator channels of recorded
+		/// seats within [begin, end) in the channel-major @p actuators array.
+		void writeActuators(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount) const;
+
+		/// @brief Move the playhead on by @p dt seconds of playback. Called
+		/// once per tick, after every range has been written.
+		void advance(double dt);
+
+		/// Blocks taken from the read-ahead windows of all streams.
+		boost::uint64_t prefetched() const;
+		/// Blocks read on the calling thread because they were not ready.
+		boost::uint64_t misses() const;
+
+	private:
+		class Stream;
+		typedef boost::shared_ptr<Stream> StreamPtr;
+
+		/// a stream and when its next tick was recorded
+		struct Due {
+			boost::uint64_t usec;
+			std::size_t stream;
+		};
+
+		void locate(boost::uint64_t usec);
+		boost::uint64_t playheadUsec() const;
+
+		std::vector<StreamPtr> m_streams;
+		/// min-heap (on usec) of the streams that have ticks left
+		std::vector<Due> m_heap;
+		boost::uint64_t m_firstUsec;
+		boost::uint64_t m_lastUsec;
+		/// microseconds from m_firstUsec
+		double m_position;
+		double m_speed;
+		double m_loopBegin;
+		double m_loopEnd;
+		/// current record per simulated seat, NULL if not recorded
+		std::vector<const SampleRecord *> m_frame;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformReplay_h_GUID_E17B6C02_94A3_4D5E_B8F1_2C6A09D7E543
@@ -0,0 +1,159 @@
+/** @file
+	@brief Implementation of the work-stealing tick scheduler.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformScheduler.h"
+#include "MotionPlatformProbes.h"
+#include "MotionPlatformStats.h"
+
+// Library/third-party includes
+#include <boost/bind/bind.hpp>
+#include <boost/static_assert.hpp>
+
+// Standard includes
+#include <algorithm>
+
+namespace motionplatform {
+
+	Scheduler::Scheduler(SimulationPtr const &sim, std::size_t workerCount, std::size_t chunkSize)
+		: m_sim(sim), m_workerCount(std::max<std::size_t>(workerCount, 1)),
+		m_chunkSize(std::max<std::size_t>(chunkSize, 1)),
+		m_chunkCount((sim->seatCount() + m_chunkSize - 1) / m_chunkSize),
+		m_dt(0), m_stopping(false), m_runs(m_workerCount), m_stolen(0),
+		m_workerMinorFaults(0), m_workerMajorFaults(0),
+		m_start(static_cast<unsigned>(m_workerCount)),
+		m_finish(static_cast<unsigned>(m_workerCount)), m_gate(GATE_CLOSED) {
+		BOOST_STATIC_ASSERT(sizeof(Run) == 64);
+		try {
+			for (std::size_t i = 1; i < m_workerCount; ++i) {
+				m_threads.create_thread(boost::bind(&Scheduler::workerMain, this, i));
+			}
+		} catch (...) {
+			/// the pool is short, so the barriers would never open: let the
+			/// workers that did start go before the members they use do
+			openGate(GATE_ABORTED);
+			m_threads.join_all();
+			throw;
+		}
+		openGate(GATE_OPEN);
+	}
+
+	Scheduler::~Scheduler() {
+		if (m_workerCount > 1) {
+			m_stopping = true;
+			m_start.wait();
+			m_threads.join_all();
+		}
+	}
+
+	void Scheduler::step(double dt) {
+		MOTIONPLATFORM_PROBE_TICK_START(m_sim->tick() + 1, m_sim->seatCount());
+		if (m_workerCount == 1) {
+			m_sim->step(dt);
+		} else {
+			m_dt = dt;
+			assignRuns();
+			/// barriers order the plain writes above against the workers
+			m_start.wait();
+			runTick(0);
+			m_finish.wait();
+			m_sim->commitTick(m_dt);
+		}
+		MOTIONPLATFORM_PROBE_SAMPLE_GENERATED(m_sim->tick(), m_sim->seatCount());
+	}
+
+	void Scheduler::openGate(Gate gate) {
+		{
+			boost::mutex::scoped_lock lock(m_gateMutex);
+			m_gate = gate;
+		}
+		m_gateChanged.notify_all();
+	}
+
+	void Scheduler::workerMain(std::size_t self) {
+		{
+			boost::mutex::scoped_lock lock(m_gateMutex);
+			while (m_gate == GATE_CLOSED) {
+				m_gateChanged.wait(lock);
+			}
+			if (m_gate == GATE_ABORTED) {
+				return;
+			}
+		}
+		for (;;) {
+			m_start.wait();
+			if (m_stopping) {
+				return;
+			}
+			boost::uint64_t minorBefore, majorBefore, minorAfter, majorAfter;
+			threadPageFaults(minorBefore, majorBefore);
+			runTick(self);
+			threadPageFaults(minorAfter, majorAfter);
+			m_workerMinorFaults.fetch_add(minorAfter - minorBefore, boost::memory_order_relaxed);
+			m_workerMajorFaults.fetch_add(majorAfter - majorBefore, boost::memory_order_relaxed);
+			m_finish.wait();
+		}
+	}
+
+	void Scheduler::pageFaults(boost::uint64_t &minor, boost::uint64_t &major) const {
+		threadPageFaults(minor, major);
+		minor += m_workerMinorFaults.load(boost::memory_order_relaxed);
+		major += m_workerMajorFaults.load(boost::memory_order_relaxed);
+	}
+
+	/*
+	 * Drain our own run of chunks, then steal from the others
+	 */
+	void Scheduler::runTick(std::size_t self) {
+		const std::size_t seats = m_sim->seatCount();
+		for (std::size_t n = 0; n < m_workerCount; ++n) {
+			std::size_t victim = (self + n) % m_workerCount;
+			Run &run = m_runs[victim];
+			for (;;) {
+				std::size_t chunk = run.next.fetch_add(1, boost::memory_order_relaxed);
+				if (chunk >= run.end) {
+					break;
+				}
+				if (victim != self) {
+					m_stolen.fetch_add(1, boost::memory_order_relaxed);
+				}
+				std::size_t begin = chunk * m_chunkSize;
+				m_sim->update(begin, std::min(begin + m_chunkSize, seats), m_dt);
+			}
+		}
+	}
+
+	void Scheduler::assignRuns() {
+		std::size_t perWorker = m_chunkCount / m_workerCount;
+		std::size_t extra = m_chunkCount % m_workerCount;
+		std::size_t begin = 0;
+		for (std::size_t i = 0; i < m_workerCount; ++i) {
+			std::size_t count = perWorker + (i < extra ? 1 : 0);
+			m_runs[i].next.store(begin, boost::memory_order_relaxed);
+			m_runs[i].end = begin + count;
+			begin += count;
+		}
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,125 @@
+/** @file
+	@brief Work-stealing tick scheduler that spreads the simulation of many
+	seats over a small pool of worker threads.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformScheduler_h_GUID_9C3F6B1E_27D4_4A85_B0E2_6F1D4C8A5E37
+#define INCLUDED_MotionPlatformScheduler_h_GUID_9C3F6B1E_27D4_4A85_B0E2_6F1D4C8A5E37
+
+// Internal Includes
+#include "MotionPlatformSimulation.h"
+
+// Library/third-party includes
+#include <boost/align/aligned_allocator.hpp>
+#include <boost/atomic.hpp>
+#include <boost/config.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace motionplatform {
+
+	typedef boost::shared_ptr<Simulation> SimulationPtr;
+
+	/// @brief Runs one simulation tick across a fixed pool of threads.
+	///
+	/// Seats are cut into chunks and each worker is handed a contiguous run of
+	/// chunks. A worker drains its own run first and then steals remaining
+	/// chunks from the others, so an unlucky (preempted) worker does not hold
+	/// up the tick. Every worker meets a barrier at the end of the tick, and
+	/// step() only returns once that barrier has been passed, i.e. before the
+	/// caller starts sending.
+	///
+	/// The calling thread acts as worker 0, so a pool of one runs inline with
+	/// no synchronization at all. Since every seat has its own generator state,
+	/// the output does not depend on the number of workers.
+	class Scheduler : boost::noncopyable {
+	public:
+		/// @throws boost::thread_resource_error if a worker cannot be
+		/// started; the workers already started are stopped first.
+		Scheduler(SimulationPtr const &sim, std::size_t workerCount, std::size_t chunkSize = 32);
+		~Scheduler();
+
+		/// @brief Advance the whole simulation by one tick of @p dt seconds.
+		void step(double dt);
+
+		Simulation &simulation() const { return *m_sim; }
+		std::size_t workerCount() const { return m_workerCount; }
+
+		/// Chunks taken from another worker's run since construction.
+		boost::uint64_t stolenChunks() const { return m_stolen.load(boost::memory_order_relaxed); }
+
+		/// @brief Page faults the calling thread has taken so far, plus those
+		/// the other workers took while updating. The difference across
+		/// step() is what that tick's update cost on every thread.
+		void pageFaults(boost::uint64_t &minor, boost::uint64_t &major) const;
+
+	private:
+		/// Aligned to, and so padded out to, a 64-byte cache line, so
+		/// neighbouring workers do not false-share. m_runs allocates them
+		/// aligned too: new[] only guarantees the alignment of a plain
+		/// pointer before C++17.
+		struct BOOST_ALIGNMENT(64) Run {
+			boost::atomic<std::size_t> next;
+			std::size_t end;
+		};
+
+		/// Workers wait here until the whole pool is started, since the
+		/// barriers need every one of them.
+		enum Gate { GATE_CLOSED, GATE_OPEN, GATE_ABORTED };
+
+		void openGate(Gate gate);
+		void workerMain(std::size_t self);
+		void runTick(std::size_t self);
+		void assignRuns();
+
+		SimulationPtr m_sim;
+		std::size_t m_workerCount;
+		std::size_t m_chunkSize;
+		std::size_t m_chunkCount;
+		double m_dt;
+		bool m_stopping;
+		std::vector<Run, boost::alignment::aligned_allocator<Run> > m_runs;
+		boost::atomic<boost::uint64_t> m_stolen;
+		boost::atomic<boost::uint64_t> m_workerMinorFaults;
+		boost::atomic<boost::uint64_t> m_workerMajorFaults;
+		boost::barrier m_start;
+		boost::barrier m_finish;
+		boost::mutex m_gateMutex;
+		boost::condition_variable m_gateChanged;
+		Gate m_gate;
+		boost::thread_group m_threads;
+	};
+
+	typedef boost::shared_ptr<Scheduler> SchedulerPtr;
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformScheduler_h_GUID_9C3F6B1E_27D4_4A85_B0E2_6F1D4C8A5E37
@@ -0,0 +1,200 @@
+/** @file
+	@brief Implementation of the motion script parser and player.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformScript.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace motionplatform {
+
+	namespace {
+
+		bool parseAxis(std::string const &name, unsigned &axis) {
+			static const char *const names[3] = { "pitch", "yaw", "roll" };
+			for (unsigned i = 0; i < 3; ++i) {
+				if (name == names[i]) {
+					axis = i;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		inline float clampAngle(float value, float limit) {
+			return std::max(-limit, std::min(limit, value));
+		}
+
+	} // namespace
+
+	bool parseScript(std::string const &text, Script &script, std::string &error) {
+		Script result;
+		std::string normalized(text);
+		std::replace(normalized.begin(), normalized.end(), '\n', ';');
+		std::istringstream statements(normalized);
+		std::string statement;
+		for (unsigned number = 1; std::getline(statements, statement, ';'); ++number) {
+			std::istringstream is(statement);
+			std::string op;
+			if (!(is >> op)) {
+				continue; // blank statement
+			}
+			std::ostringstream where;
+			where << "statement " << number << " (" << op << "): ";
+			if (result.loop) {
+				error = where.str() + "nothing may follow loop";
+				return false;
+			}
+			if (op == "loop") {
+				result.loop = true;
+				continue;
+			}
+			ScriptSegment segment = ScriptSegment();
+			std::string axis;
+			if (op == "ramp") {
+				segment.kind = ScriptSegment::RAMP;
+				is >> axis >> segment.value >> segment.duration;
+			} else if (op == "hold") {
+				segment.kind = ScriptSegment::HOLD;
+				is >> segment.duration;
+			} else if (op == "oscillate") {
+				segment.kind = ScriptSegment::OSCILLATE;
+				is >> axis >> segment.value >> segment.frequency >> segment.duration;
+			} else {
+				error = where.str() + "unknown statement";
+				return false;
+			}
+			std::string extra;
+			if (is.fail() || (is >> extra)) {
+				error = where.str() + "wrong arguments";
+				return false;
+			}
+			if (segment.kind != ScriptSegment::HOLD && !parseAxis(axis, segment.axis)) {
+				error = where.str() + "axis must be pitch, yaw or roll";
+				return false;
+			}
+			if (!(segment.duration > 0) || segment.frequency < 0) {
+				error = where.str() + "duration must be positive and frequency not negative";
+				return false;
+			}
+			result.segments.push_back(segment);
+		}
+		if (result.segments.empty()) {
+			error = "script has no segments";
+			return false;
+		}
+		script = result;
+		return true;
+	}
+
+	ScriptPlayer::ScriptPlayer(std::size_t seatCount, float maxAngle)
+		: m_maxAngle(maxAngle), m_owner(seatCount),
+		m_script(seatCount, static_cast<const Script *>(NULL)), m_segment(seatCount),
+		m_elapsed(seatCount), m_origin(seatCount) {
+		for (int axis = 0; axis < 3; ++axis) {
+			m_angle[axis].resize(seatCount);
+		}
+	}
+
+	void ScriptPlayer::assign(std::size_t seat, ScriptPtr const &script) {
+		m_owner[seat] = script;
+		m_script[seat] = script.get();
+		m_segment[seat] = 0;
+		m_elapsed[seat] = 0;
+		m_origin[seat] = 0;
+		for (int axis = 0; axis < 3; ++axis) {
+			m_angle[axis][seat] = 0;
+		}
+	}
+
+	/*
+	 * Angle the segment's axis is left at when the segment completes
+	 */
+	float ScriptPlayer::endValue(ScriptSegment const &segment, float origin) const {
+		const float twoPi = boost::math::constants::two_pi<float>();
+		switch (segment.kind) {
+		case ScriptSegment::RAMP:
+			return clampAngle(segment.value, m_maxAngle);
+		case ScriptSegment::OSCILLATE:
+			return clampAngle(origin + segment.value * std::sin(twoPi * segment.frequency * segment.duration), m_maxAngle);
+		default:
+			return origin;
+		}
+	}
+
+	void ScriptPlayer::step(std::size_t begin, std::size_t end, float dt, float *pitch, float *yaw, float *roll) {
+		const float twoPi = boost::math::constants::two_pi<float>();
+		float *angles[3] = { &m_angle[0][0], &m_angle[1][0], &m_angle[2][0] };
+		float *out[3] = { pitch, yaw, roll };
+		for (std::size_t i = begin; i < end; ++i) {
+			const Script *script = m_script[i];
+			if (!script) {
+				continue;
+			}
+			const std::vector<ScriptSegment> &segments = script->segments;
+			const boost::uint32_t count = static_cast<boost::uint32_t>(segments.size());
+			boost::uint32_t current = m_segment[i];
+			float elapsed = m_elapsed[i] + dt;
+			float origin = m_origin[i];
+			// finish every segment this tick runs past; a tick longer than a
+			// whole looping script only goes around once
+			for (boost::uint32_t guard = 0; current < count && elapsed >= segments[current].duration && guard <= count; ++guard) {
+				ScriptSegment const &done = segments[current];
+				angles[done.axis][i] = endValue(done, origin);
+				elapsed -= done.duration;
+				if (++current == count && script->loop) {
+					current = 0;
+				}
+				if (current < count) {
+					origin = angles[segments[current].axis][i];
+				}
+			}
+			if (current < count) {
+				ScriptSegment const &segment = segments[current];
+				float value = origin;
+				if (segment.kind == ScriptSegment::RAMP) {
+					value = origin + (segment.value - origin) * (elapsed / segment.duration);
+				} else if (segment.kind == ScriptSegment::OSCILLATE) {
+					value = origin + segment.value * std::sin(twoPi * segment.frequency * elapsed);
+				}
+				angles[segment.axis][i] = clampAngle(value, m_maxAngle);
+			} else {
+				elapsed = 0; // finished: hold the end pose
+			}
+			m_segment[i] = current;
+			m_elapsed[i] = elapsed;
+			m_origin[i] = origin;
+			for (int axis = 0; axis < 3; ++axis) {
+				out[axis][i] = angles[axis][i];
+			}
+		}
+	}
+
+} // namespace motionplatform
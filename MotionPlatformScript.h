@@ -0,0 +1,123 @@
+/** @file
+	@brief Scripted motion sequences (ramp, hold, oscillate) played back per
+	seat by the simulation tick.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformScript_h_GUID_3E9B6D14_A2C7_4F05_B8E1_7D40C5F2A913
+#define INCLUDED_MotionPlatformScript_h_GUID_3E9B6D14_A2C7_4F05_B8E1_7D40C5F2A913
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief One step of a motion script, acting on a single axis.
+	struct ScriptSegment {
+		enum Kind {
+			/// move linearly from the current angle to @c value degrees
+			RAMP,
+			/// keep every axis where it is
+			HOLD,
+			/// swing around the current angle by @c value degrees at
+			/// @c frequency Hz
+			OSCILLATE
+		};
+		Kind kind;
+		/// 0 pitch, 1 yaw, 2 roll (unused by HOLD)
+		unsigned axis;
+		float value;
+		float frequency;
+		/// seconds, always positive
+		float duration;
+	};
+
+	/// @brief A parsed motion script.
+	struct Script {
+		Script() : loop(false) {}
+		std::vector<ScriptSegment> segments;
+		/// start over after the last segment instead of holding its end pose
+		bool loop;
+	};
+	typedef boost::shared_ptr<const Script> ScriptPtr;
+
+	/// @brief Parse a script made of statements separated by ';' or newlines:
+	///
+	///     ramp <pitch|yaw|roll> <degrees> <seconds>
+	///     hold <seconds>
+	///     oscillate <pitch|yaw|roll> <amplitude degrees> <hz> <seconds>
+	///     loop
+	///
+	/// e.g. "ramp pitch 10 2; hold 1; oscillate roll 5 1 4". @c loop may only
+	/// be the last statement.
+	/// @return false, with @p error set, if @p text is not a valid script.
+	bool parseScript(std::string const &text, Script &script, std::string &error);
+
+	/// @brief Plays scripts on any number of seats at once.
+	///
+	/// Every seat has a cursor (current segment, time into it, angle it started
+	/// from) stored one array per field like the simulation's own state, so a
+	/// script resumes with a few loads and a switch and needs no thread of its
+	/// own. Seats without a script are left to the simulation's random motion.
+	class ScriptPlayer : boost::noncopyable {
+	public:
+		/// @param maxAngle scripted angles are clamped to [-maxAngle, maxAngle]
+		ScriptPlayer(std::size_t seatCount, float maxAngle);
+
+		/// @brief Start @p script on @p seat from rest, or stop scripting the
+		/// seat if @p script is null. Must not be called during a step.
+		void assign(std::size_t seat, ScriptPtr const &script);
+
+		/// @brief Advance the scripted seats in [begin, end) by @p dt seconds
+		/// and write their angles (degrees) over the given per-seat arrays.
+		/// Disjoint ranges may be stepped concurrently.
+		void step(std::size_t begin, std::size_t end, float dt, float *pitch, float *yaw, float *roll);
+
+	private:
+		float endValue(ScriptSegment const &segment, float origin) const;
+
+		float m_maxAngle;
+		/// keeps each seat's script alive; the step only reads m_script
+		std::vector<ScriptPtr> m_owner;
+
+		// per-seat cursors
+		std::vector<const Script *> m_script;
+		std::vector<boost::uint32_t> m_segment;
+		std::vector<float> m_elapsed;
+		std::vector<float> m_origin;
+		// per-seat scripted angles, one array per axis
+		std::vector<float> m_angle[3];
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformScript_h_GUID_3E9B6D14_A2C7_4F05_B8E1_7D40C5F2A913
@@ -0,0 +1,194 @@
+/** @file
+	@brief Implementation of the wavetable test signal generator.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformSignal.h"
+#include "MotionPlatformSimulation.h"
+
+// Library/third-party includes
+#include <boost/make_shared.hpp>
+#include <boost/math/constants/constants.hpp>
+#include <boost/static_assert.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace motionplatform {
+
+	namespace {
+		/// the table index is the top TABLE_BITS of the phase
+		const unsigned TABLE_BITS = 12;
+		const unsigned FRACTION_BITS = 32 - TABLE_BITS;
+		const unsigned MAX_TONES = 256;
+	} // namespace
+
+	const std::size_t SignalGenerator::TABLE_SIZE;
+	BOOST_STATIC_ASSERT(SignalGenerator::TABLE_SIZE == 1u << TABLE_BITS);
+
+	SignalGenerator::SignalGenerator() {}
+
+	/*
+	 * Single tone table, shared by every sine and chirp
+	 */
+	SignalGenerator::TablePtr SignalGenerator::sineTable() {
+		static const TablePtr table = multisineTable(1);
+		return table;
+	}
+
+	/*
+	 * One period of the first @p tones harmonics with Schroeder phases,
+	 * scaled to a peak of 1, plus a guard sample so interpolation never wraps
+	 */
+	SignalGenerator::TablePtr SignalGenerator::multisineTable(unsigned tones) {
+		const double pi = boost::math::constants::pi<double>();
+		std::vector<double> sum(TABLE_SIZE);
+		for (unsigned k = 1; k <= tones; ++k) {
+			const double phase = -pi * k * (k - 1) / tones;
+			for (std::size_t n = 0; n < TABLE_SIZE; ++n) {
+				sum[n] += std::cos(2 * pi * k * n / TABLE_SIZE + phase);
+			}
+		}
+		double peak = 0;
+		for (std::size_t n = 0; n < TABLE_SIZE; ++n) {
+			peak = std::max(peak, std::fabs(sum[n]));
+		}
+		boost::shared_ptr<std::vector<float> > table = boost::make_shared<std::vector<float> >(TABLE_SIZE + 1);
+		for (std::size_t n = 0; n < TABLE_SIZE; ++n) {
+			(*table)[n] = static_cast<float>(sum[n] / peak);
+		}
+		(*table)[TABLE_SIZE] = (*table)[0];
+		return table;
+	}
+
+	bool SignalGenerator::add(std::size_t channel, std::string const &spec, std::string &error) {
+		if (channel >= Simulation::ACTUATOR_COUNT) {
+			error = "no such channel";
+			return false;
+		}
+		std::istringstream is(spec);
+		std::string kind;
+		is >> kind;
+		Channel signal = Channel();
+		signal.channel = channel;
+		unsigned tones = 1;
+		if (kind == "sine") {
+			is >> signal.startFrequency >> signal.amplitude;
+			signal.endFrequency = signal.startFrequency;
+		} else if (kind == "multisine") {
+			is >> signal.startFrequency >> tones >> signal.amplitude;
+			signal.endFrequency = signal.startFrequency * tones;
+		} else if (kind == "chirp") {
+			is >> signal.startFrequency >> signal.endFrequency >> signal.sweepSeconds >> signal.amplitude;
+		} else {
+			error = "unknown signal '" + kind + "'";
+			return false;
+		}
+		std::string extra;
+		if (is.fail() || (is >> extra)) {
+			error = "wrong arguments for " + kind;
+			return false;
+		}
+		if (!(signal.startFrequency > 0 && signal.endFrequency > 0) ||
+			(kind == "chirp" && !(signal.sweepSeconds > 0))) {
+			error = "frequencies and sweep time must be positive";
+			return false;
+		}
+		if (tones < 1 || tones > MAX_TONES) {
+			error = "a multisine has 1 to 256 tones";
+			return false;
+		}
+		if (!(signal.amplitude >= 0 && signal.amplitude <= 1)) {
+			error = "amplitude must be within [0, 1]";
+			return false;
+		}
+		signal.table = kind == "multisine" ? multisineTable(tones) : sineTable();
+		signal.frequency = signal.startFrequency;
+		if (kind != "multisine") {
+			// the table holds a cosine: start three quarters in to get a sine
+			signal.phase = 3u << 30;
+		}
+		sample(signal);
+
+		for (std::size_t i = 0; i < m_channels.size(); ++i) {
+			if (m_channels[i].channel == channel) {
+				m_channels[i] = signal;
+				return true;
+			}
+		}
+		m_channels.push_back(signal);
+		return true;
+	}
+
+	double SignalGenerator::maxFrequency() const {
+		double highest = 0;
+		for (std::size_t i = 0; i < m_channels.size(); ++i) {
+			highest = std::max(highest, std::max(m_channels[i].startFrequency, m_channels[i].endFrequency));
+		}
+		return highest;
+	}
+
+	void SignalGenerator::write(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount) const {
+		for (std::size_t i = 0; i < m_channels.size(); ++i) {
+			float *channel = actuators + m_channels[i].channel * seatCount;
+			std::fill(channel + begin, channel + end, m_channels[i].value);
+		}
+	}
+
+	void SignalGenerator::advance(double dt) {
+		for (std::size_t i = 0; i < m_channels.size(); ++i) {
+			Channel &signal = m_channels[i];
+			double cycles = signal.frequency * dt;
+			cycles -= std::floor(cycles);
+			signal.phase += static_cast<boost::uint32_t>(static_cast<boost::uint64_t>(cycles * 4294967296.0));
+			if (signal.sweepSeconds > 0) {
+				if (dt != signal.lastDt) {
+					/// only recomputed when the tick length changes
+					signal.ratio = std::exp(std::log(signal.endFrequency / signal.startFrequency) / signal.sweepSeconds * dt);
+					signal.lastDt = dt;
+				}
+				signal.elapsed += dt;
+				signal.frequency *= signal.ratio;
+				if (signal.elapsed >= signal.sweepSeconds) {
+					signal.elapsed = 0;
+					signal.frequency = signal.startFrequency;
+				}
+			}
+			sample(signal);
+		}
+	}
+
+	/*
+	 * Linear interpolation between the two table entries around the phase
+	 */
+	void SignalGenerator::sample(Channel &signal) const {
+		const std::vector<float> &table = *signal.table;
+		const boost::uint32_t index = signal.phase >> FRACTION_BITS;
+		const float fraction = static_cast<float>(signal.phase & ((1u << FRACTION_BITS) - 1)) * (1.0f / (1u << FRACTION_BITS));
+		const float value = table[index] + (table[index + 1] - table[index]) * fraction;
+		signal.value = signal.amplitude * value;
+	}
+
+} // namespace motionplatform
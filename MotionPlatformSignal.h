@@ -0,0 +1,118 @@
+/** @file
+	@brief Test signals (sine, Schroeder multisine, logarithmic chirp) played
+	from precomputed wavetables on the actuator channels.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformSignal_h_GUID_D05A7E38_6B1F_4C92_9E4D_2F8A13C6B5E7
+#define INCLUDED_MotionPlatformSignal_h_GUID_D05A7E38_6B1F_4C92_9E4D_2F8A13C6B5E7
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief Plays one test signal per actuator channel, the same on every
+	/// seat, for measuring the frequency response of whatever consumes the
+	/// channels.
+	///
+	/// A signal is given as one of
+	///
+	///     sine <hz> <amplitude>
+	///     multisine <base hz> <tones> <amplitude>
+	///     chirp <start hz> <end hz> <seconds> <amplitude>
+	///
+	/// A multisine sums the first @c tones harmonics of the base frequency with
+	/// Schroeder phases, which keeps its crest factor low. A chirp sweeps
+	/// logarithmically and starts over at the end of each sweep.
+	///
+	/// Every waveform is precomputed into a single-period table when the
+	/// signal is added. Playback advances a 32-bit phase accumulator once per
+	/// tick and interpolates the table, so no trigonometry runs per sample.
+	/// Amplitudes are limited to 1 so the channels stay within the [-1, 1]
+	/// traits of the JSON descriptor.
+	class SignalGenerator : boost::noncopyable {
+	public:
+		/// Samples per table period
+		static const std::size_t TABLE_SIZE = 4096;
+
+		SignalGenerator();
+
+		/// @brief Play @p spec on @p channel, replacing what it played.
+		/// @return false, with @p error set, if @p spec is invalid.
+		bool add(std::size_t channel, std::string const &spec, std::string &error);
+
+		bool empty() const { return m_channels.empty(); }
+
+		/// @brief Highest frequency (Hz) any signal reaches; keep it below half
+		/// the tick rate.
+		double maxFrequency() const;
+
+		/// @brief Write the current sample of every signal to seats [begin,
+		/// end) of the channel-major @p actuators array. Disjoint ranges may be
+		/// written concurrently.
+		void write(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount) const;
+
+		/// @brief Move every signal on by @p dt seconds. Called once per tick,
+		/// after every range has been written.
+		void advance(double dt);
+
+	private:
+		typedef boost::shared_ptr<const std::vector<float> > TablePtr;
+
+		struct Channel {
+			std::size_t channel;
+			TablePtr table;
+			float amplitude;
+			/// cycles of the table per second, swept for chirps
+			double frequency;
+			double startFrequency;
+			double endFrequency;
+			double sweepSeconds;
+			double elapsed;
+			/// frequency growth over one tick of lastDt
+			double ratio;
+			double lastDt;
+			boost::uint32_t phase;
+			float value;
+		};
+
+		static TablePtr sineTable();
+		static TablePtr multisineTable(unsigned tones);
+		void sample(Channel &channel) const;
+
+		std::vector<Channel> m_channels;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformSignal_h_GUID_D05A7E38_6B1F_4C92_9E4D_2F8A13C6B5E7
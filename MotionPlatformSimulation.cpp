@@ -0,0 +1,231 @@
+/** @file
+	@brief Implementation of the structure-of-arrays simulation core.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformSimulation.h"
+#include "MotionPlatformExpression.h"
+#include "MotionPlatformNoise.h"
+#include "MotionPlatformReplay.h"
+#include "MotionPlatformScript.h"
+#include "MotionPlatformSignal.h"
+#include "MotionPlatformVibration.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// Standard includes
+#include <cmath>
+
+/// With MOTIONPLATFORM_SIMD_DISPATCH the per-seat loops are compiled once per
+/// instruction set and the best clone is picked when the library loads.
+#if defined(MOTIONPLATFORM_SIMD_DISPATCH) && defined(__GNUC__) && defined(__linux__)
+#define MOTIONPLATFORM_KERNEL __attribute__((target_clones("avx2", "default")))
+#else
+#define MOTIONPLATFORM_KERNEL
+#endif
+
+namespace motionplatform {
+
+	const std::size_t Simulation::ACTUATOR_COUNT;
+	const std::size_t Simulation::TARGET_ANGLE_CHANNEL;
+
+	Simulation::Simulation(std::size_t seatCount, boost::uint32_t seed)
+		: m_seatCount(seatCount), m_tick(0), m_time(0), m_trace(NULL), m_noise(NULL), m_scripts(NULL), m_replay(NULL), m_signals(NULL), m_vibration(NULL), m_expressions(NULL), m_maxAngle(45.0f),
+		m_rngState(seatCount),
+		m_targetPitch(seatCount), m_targetYaw(seatCount), m_targetRoll(seatCount),
+		m_pitch(seatCount), m_yaw(seatCount), m_roll(seatCount),
+		m_pitchVelocity(seatCount), m_yawVelocity(seatCount), m_rollVelocity(seatCount),
+		m_quatX(seatCount), m_quatY(seatCount), m_quatZ(seatCount), m_quatW(seatCount, 1.0f),
+		m_actuators(seatCount * ACTUATOR_COUNT) {
+		/// Seed each seat's small generator from one Mersenne Twister so the
+		/// per-seat state stays four bytes instead of a full mt19937.
+		boost::mt19937 seeder(seed);
+		for (std::size_t i = 0; i < seatCount; ++i) {
+			boost::uint32_t s = seeder();
+			m_rngState[i] = s ? s : 1u; // xorshift must not start at zero
+		}
+	}
+
+	void Simulation::step(double dt) {
+		update(0, m_seatCount, dt);
+		commitTick(dt);
+	}
+
+	void Simulation::update(std::size_t begin, std::size_t end, double dt) {
+		const boost::uint64_t tick = m_tick + 1;
+		{
+			TraceScope scope(m_trace, "generate", tick);
+			generate(begin, end);
+		}
+		if (m_scripts) {
+			TraceScope scope(m_trace, "script", tick);
+			m_scripts->step(begin, end, static_cast<float>(dt), &m_targetPitch[0], &m_targetYaw[0], &m_targetRoll[0]);
+		}
+		if (m_replay) {
+			TraceScope scope(m_trace, "replay", tick);
+			m_replay->writeTargets(begin, end, &m_targetPitch[0], &m_targetYaw[0], &m_targetRoll[0]);
+		}
+		{
+			TraceScope scope(m_trace, "integrate", tick);
+			integrate(begin, end, dt > 0 ? static_cast<float>(1.0 / dt) : 0.0f);
+		}
+		{
+			TraceScope scope(m_trace, "convert", tick);
+			convert(begin, end);
+		}
+		{
+			TraceScope scope(m_trace, "actuate", tick);
+			actuate(begin, end);
+			if (m_replay) {
+				m_replay->writeActuators(begin, end, &m_actuators[0], m_seatCount);
+			}
+		}
+		if (m_signals) {
+			TraceScope scope(m_trace, "signals", tick);
+			m_signals->write(begin, end, &m_actuators[0], m_seatCount);
+		}
+		if (m_vibration) {
+			TraceScope scope(m_trace, "vibration", tick);
+			m_vibration->mix(begin, end, &m_actuators[0], m_seatCount);
+		}
+		if (m_expressions) {
+			TraceScope scope(m_trace, "expressions", tick);
+			m_expressions->evaluate(begin, end, m_time + dt, &m_actuators[0], m_seatCount);
+		}
+	}
+
+	void Simulation::commitTick(double dt) {
+		++m_tick;
+		m_time += dt;
+		if (m_signals) {
+			/// every range has written this tick's samples by now
+			m_signals->advance(dt);
+		}
+		if (m_replay) {
+			m_replay->advance(dt);
+		}
+	}
+
+	void Simulation::getOrientation(std::size_t seat, double quat[4]) const {
+		quat[0] = m_quatX[seat];
+		quat[1] = m_quatY[seat];
+		quat[2] = m_quatZ[seat];
+		quat[3] = m_quatW[seat];
+	}
+
+	void Simulation::getActuators(std::size_t seat, double values[ACTUATOR_COUNT]) const {
+		for (std::size_t c = 0; c < ACTUATOR_COUNT; ++c) {
+			values[c] = m_actuators[c * m_seatCount + seat];
+		}
+	}
+
+	/*
+	 * Draw new uniformly distributed integer angles in [-max, max] degrees,
+	 * or the next colored noise samples if a noise generator is set
+	 */
+	void Simulation::generate(std::size_t begin, std::size_t end) {
+		if (m_noise) {
+			m_noise->generate(begin, end, m_maxAngle, &m_targetPitch[0], &m_targetYaw[0], &m_targetRoll[0]);
+			return;
+		}
+		const boost::uint32_t span = static_cast<boost::uint32_t>(2 * m_maxAngle + 1);
+		const float offset = m_maxAngle;
+		boost::uint32_t *state = &m_rngState[0];
+		float *out[3] = { &m_targetPitch[0], &m_targetYaw[0], &m_targetRoll[0] };
+		for (std::size_t i = begin; i < end; ++i) {
+			boost::uint32_t x = state[i];
+			for (int axis = 0; axis < 3; ++axis) {
+				x ^= x << 13;
+				x ^= x >> 17;
+				x ^= x << 5;
+				out[axis][i] = static_cast<float>((static_cast<boost::uint64_t>(x) * span) >> 32) - offset;
+			}
+			state[i] = x;
+		}
+	}
+
+	MOTIONPLATFORM_KERNEL void Simulation::integrate(std::size_t begin, std::size_t end, float invDt) {
+		for (std::size_t i = begin; i < end; ++i) {
+			m_pitchVelocity[i] = (m_targetPitch[i] - m_pitch[i]) * invDt;
+			m_yawVelocity[i] = (m_targetYaw[i] - m_yaw[i]) * invDt;
+			m_rollVelocity[i] = (m_targetRoll[i] - m_roll[i]) * invDt;
+		}
+		for (std::size_t i = begin; i < end; ++i) {
+			m_pitch[i] = m_targetPitch[i];
+			m_yaw[i] = m_targetYaw[i];
+			m_roll[i] = m_targetRoll[i];
+		}
+	}
+
+	/*
+	 * Convert the euler angles to quaternions
+	 */
+	void Simulation::convert(std::size_t begin, std::size_t end) {
+		// Basically we create 3 Quaternions, one for pitch, one for yaw, one for roll
+		// and multiply those together.
+		// the calculation below does the same, just shorter
+		const float halfRad = boost::math::constants::pi<float>() / 180.0f / 2.0f;
+		for (std::size_t i = begin; i < end; ++i) {
+			float p = m_pitch[i] * halfRad;
+			float y = m_yaw[i] * halfRad;
+			float r = m_roll[i] * halfRad;
+
+			float sinp = std::sin(p);
+			float siny = std::sin(y);
+			float sinr = std::sin(r);
+			float cosp = std::cos(p);
+			float cosy = std::cos(y);
+			float cosr = std::cos(r);
+
+			m_quatX[i] = sinr * cosp * cosy - cosr * sinp * siny;
+			m_quatY[i] = cosr * sinp * cosy + sinr * cosp * siny;
+			m_quatZ[i] = cosr * cosp * siny - sinr * sinp * cosy;
+			m_quatW[i] = cosr * cosp * cosy + sinr * sinp * siny;
+		}
+	}
+
+	/*
+	 * Map the current state onto the six normalized actuator channels
+	 */
+	MOTIONPLATFORM_KERNEL void Simulation::actuate(std::size_t begin, std::size_t end) {
+		const float invMax = 1.0f / m_maxAngle;
+		// no translation model yet: displacement channels stay at rest
+		for (std::size_t c = 0; c < TARGET_ANGLE_CHANNEL; ++c) {
+			float *channel = actuatorChannel(c);
+			for (std::size_t i = begin; i < end; ++i) {
+				channel[i] = 0.0f;
+			}
+		}
+		float *angleX = actuatorChannel(TARGET_ANGLE_CHANNEL);
+		float *angleY = actuatorChannel(TARGET_ANGLE_CHANNEL + 1);
+		float *angleZ = actuatorChannel(TARGET_ANGLE_CHANNEL + 2);
+		for (std::size_t i = begin; i < end; ++i) {
+			angleX[i] = m_pitch[i] * invMax;
+			angleY[i] = m_yaw[i] * invMax;
+			angleZ[i] = m_roll[i] * invMax;
+		}
+	}
+
+} // namespace motionplatform
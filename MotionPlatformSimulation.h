@@ -0,0 +1,172 @@
+/** @file
+	@brief Structure-of-arrays simulation core shared by every simulated
+	motion platform seat.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformSimulation_h_GUID_5B0E1C2A_8E4D_4F7B_9A61_3C2D7E8F1A90
+#define INCLUDED_MotionPlatformSimulation_h_GUID_5B0E1C2A_8E4D_4F7B_9A61_3C2D7E8F1A90
+
+// Internal Includes
+#include "MotionPlatformTrace.h"
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace motionplatform {
+
+	class ExpressionSet;
+	class NoiseGenerator;
+	class ReplayPlayer;
+	class ScriptPlayer;
+	class SignalGenerator;
+	class VibrationBank;
+
+	/// @brief Simulation state for all seats, stored one array per field so the
+	/// per-tick loops walk contiguous memory.
+	///
+	/// Device objects do not own any simulation state: they hold a seat index
+	/// and only read the arrays back when sending to OSVR.
+	class Simulation {
+	public:
+		/// Number of actuator (analog) channels per seat: target displacement
+		/// x/y/z followed by target angle x/y/z.
+		static const std::size_t ACTUATOR_COUNT = 6;
+
+		/// Index of the first target angle channel in the actuator block.
+		static const std::size_t TARGET_ANGLE_CHANNEL = 3;
+
+		explicit Simulation(std::size_t seatCount, boost::uint32_t seed = 5489u);
+
+		/// @brief Advance every seat by one tick of @p dt seconds.
+		void step(double dt);
+
+		/// @brief Advance seats [begin, end) only. The tick counter is left
+		/// alone so several ranges can make up one tick.
+		void update(std::size_t begin, std::size_t end, double dt);
+
+		/// @brief Record the phases of every update into @p trace (may be
+		/// null to stop tracing). The trace must outlive the simulation's use.
+		void setTrace(Trace *trace) { m_trace = trace; }
+
+		/// @brief Draw target angles from @p noise instead of uniformly (may
+		/// be null). The generator must outlive the simulation's use.
+		void setNoise(NoiseGenerator *noise) { m_noise = noise; }
+
+		/// @brief Let @p scripts drive the seats it has a script for (may be
+		/// null). The player must outlive the simulation's use.
+		void setScripts(ScriptPlayer *scripts) { m_scripts = scripts; }
+
+		/// @brief Drive the seats @p replay has recorded from it (may be
+		/// null). The player must outlive the simulation's use.
+		void setReplay(ReplayPlayer *replay) { m_replay = replay; }
+
+		/// @brief Play test signals from @p signals on their actuator channels
+		/// (may be null). The generator must outlive the simulation's use.
+		void setSignals(SignalGenerator *signals) { m_signals = signals; }
+
+		/// @brief Mix the voices of @p vibration into the actuator channels
+		/// (may be null). The bank must outlive the simulation's use.
+		void setVibration(VibrationBank *vibration) { m_vibration = vibration; }
+
+		/// @brief Replace actuator channels with @p expressions after each
+		/// update (may be null). The set must outlive the simulation's use.
+		void setExpressions(ExpressionSet const *expressions) { m_expressions = expressions; }
+
+		/// @brief Mark the current tick, updated with @p dt, as complete.
+		void commitTick(double dt);
+
+		std::size_t seatCount() const { return m_seatCount; }
+		/// Largest angle (degrees) any axis reaches.
+		float maxAngle() const { return m_maxAngle; }
+		boost::uint64_t tick() const { return m_tick; }
+		/// Simulated seconds up to the end of the last complete tick.
+		double time() const { return m_time; }
+
+		/// Orientation of @p seat as x, y, z, w.
+		void getOrientation(std::size_t seat, double quat[4]) const;
+
+		/// Actuator values of @p seat, each in [-1, 1].
+		void getActuators(std::size_t seat, double values[ACTUATOR_COUNT]) const;
+
+		/// Euler angles in degrees, one array per axis.
+		const float *pitch() const { return &m_pitch[0]; }
+		const float *yaw() const { return &m_yaw[0]; }
+		const float *roll() const { return &m_roll[0]; }
+
+	private:
+		void generate(std::size_t begin, std::size_t end);
+		void integrate(std::size_t begin, std::size_t end, float invDt);
+		void convert(std::size_t begin, std::size_t end);
+		void actuate(std::size_t begin, std::size_t end);
+
+		/// Actuator channel @p channel lives at
+		/// m_actuators[channel * m_seatCount + seat].
+		float *actuatorChannel(std::size_t channel) {
+			return &m_actuators[channel * m_seatCount];
+		}
+
+		std::size_t m_seatCount;
+		boost::uint64_t m_tick;
+		double m_time;
+		Trace *m_trace;
+		NoiseGenerator *m_noise;
+		ScriptPlayer *m_scripts;
+		ReplayPlayer *m_replay;
+		SignalGenerator *m_signals;
+		VibrationBank *m_vibration;
+		ExpressionSet const *m_expressions;
+		float m_maxAngle;
+
+		// per-seat random number generator state
+		std::vector<boost::uint32_t> m_rngState;
+
+		// freshly drawn angles (degrees)
+		std::vector<float> m_targetPitch;
+		std::vector<float> m_targetYaw;
+		std::vector<float> m_targetRoll;
+
+		// current angles (degrees) and angular velocities (degrees/s)
+		std::vector<float> m_pitch;
+		std::vector<float> m_yaw;
+		std::vector<float> m_roll;
+		std::vector<float> m_pitchVelocity;
+		std::vector<float> m_yawVelocity;
+		std::vector<float> m_rollVelocity;
+
+		// orientation quaternion components
+		std::vector<float> m_quatX;
+		std::vector<float> m_quatY;
+		std::vector<float> m_quatZ;
+		std::vector<float> m_quatW;
+
+		// channel-major actuator states
+		std::vector<float> m_actuators;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformSimulation_h_GUID_5B0E1C2A_8E4D_4F7B_9A61_3C2D7E8F1A90
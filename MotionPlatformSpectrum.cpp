@@ -0,0 +1,204 @@
+/** @file
+	@brief Implementation of the FFT and Welch spectral estimates.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformSpectrum.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace motionplatform {
+
+	Fft::Fft(std::size_t size) : m_size(size), m_reversed(size), m_twiddles(size / 2) {
+		std::size_t bits = 0;
+		while ((std::size_t(1) << bits) < size) {
+			++bits;
+		}
+		for (std::size_t i = 0; i < size; ++i) {
+			std::size_t r = 0;
+			for (std::size_t b = 0; b < bits; ++b) {
+				r |= ((i >> b) & 1) << (bits - 1 - b);
+			}
+			m_reversed[i] = r;
+		}
+		const double step = -2 * boost::math::constants::pi<double>() / size;
+		for (std::size_t k = 0; k < size / 2; ++k) {
+			m_twiddles[k] = std::polar(1.0, step * k);
+		}
+	}
+
+	void Fft::forward(Complex *data) const { transform(data, false); }
+
+	void Fft::inverse(Complex *data) const {
+		transform(data, true);
+		const double scale = 1.0 / m_size;
+		for (std::size_t i = 0; i < m_size; ++i) {
+			data[i] *= scale;
+		}
+	}
+
+	void Fft::forwardRealPair(const double *a, const double *b, Complex *scratch, Complex *outA, Complex *outB) const {
+		for (std::size_t n = 0; n < m_size; ++n) {
+			scratch[n] = Complex(a[n], b[n]);
+		}
+		transform(scratch, false);
+		/// A[k] = (Z[k] + conj(Z[-k])) / 2, B[k] = (Z[k] - conj(Z[-k])) / 2i
+		for (std::size_t k = 0; k <= m_size / 2; ++k) {
+			const Complex z = scratch[k];
+			const Complex mirror = std::conj(scratch[(m_size - k) & (m_size - 1)]);
+			outA[k] = 0.5 * (z + mirror);
+			outB[k] = Complex(0, -0.5) * (z - mirror);
+		}
+	}
+
+	/*
+	 * Decimation in time: permute, then combine ever longer runs
+	 */
+	void Fft::transform(Complex *data, bool inverse) const {
+		for (std::size_t i = 0; i < m_size; ++i) {
+			if (i < m_reversed[i]) {
+				std::swap(data[i], data[m_reversed[i]]);
+			}
+		}
+		for (std::size_t length = 2; length <= m_size; length <<= 1) {
+			const std::size_t half = length / 2;
+			const std::size_t stride = m_size / length;
+			for (std::size_t start = 0; start < m_size; start += length) {
+				for (std::size_t j = 0; j < half; ++j) {
+					const Complex w = inverse ? std::conj(m_twiddles[j * stride]) : m_twiddles[j * stride];
+					const Complex u = data[start + j];
+					const Complex v = data[start + j + half] * w;
+					data[start + j] = u + v;
+					data[start + j + half] = u - v;
+				}
+			}
+		}
+	}
+
+	std::vector<double> hannWindow(std::size_t size) {
+		std::vector<double> window(size);
+		const double step = 2 * boost::math::constants::pi<double>() / size;
+		for (std::size_t n = 0; n < size; ++n) {
+			window[n] = 0.5 - 0.5 * std::cos(step * n);
+		}
+		return window;
+	}
+
+	WelchAccumulator::WelchAccumulator(std::size_t channels, std::size_t segmentSize,
+		std::vector<std::pair<std::size_t, std::size_t> > const &pairs)
+		: m_channels(channels), m_size(segmentSize), m_bins(segmentSize / 2 + 1), m_pairs(pairs),
+		m_segments(0), m_power(channels * m_bins), m_cross(pairs.size() * m_bins),
+		/// one spare channel of zeros pairs up with the last of an odd count
+		m_windowed((channels + 1) * segmentSize), m_scratch(segmentSize), m_spectra((channels + 1) * m_bins) {}
+
+	void WelchAccumulator::add(Fft const &fft, std::vector<double> const &window, const double *segment) {
+		for (std::size_t c = 0; c < m_channels; ++c) {
+			const double *in = segment + c * m_size;
+			double *out = &m_windowed[c * m_size];
+			double mean = 0;
+			for (std::size_t n = 0; n < m_size; ++n) {
+				mean += in[n];
+			}
+			mean /= m_size;
+			for (std::size_t n = 0; n < m_size; ++n) {
+				out[n] = (in[n] - mean) * window[n];
+			}
+		}
+		for (std::size_t c = 0; c < m_channels; c += 2) {
+			fft.forwardRealPair(&m_windowed[c * m_size], &m_windowed[(c + 1) * m_size], &m_scratch[0],
+				&m_spectra[c * m_bins], &m_spectra[(c + 1) * m_bins]);
+		}
+		for (std::size_t i = 0; i < m_power.size(); ++i) {
+			m_power[i] += std::norm(m_spectra[i]);
+		}
+		for (std::size_t p = 0; p < m_pairs.size(); ++p) {
+			const Complex *command = &m_spectra[m_pairs[p].first * m_bins];
+			const Complex *response = &m_spectra[m_pairs[p].second * m_bins];
+			Complex *cross = &m_cross[p * m_bins];
+			for (std::size_t k = 0; k < m_bins; ++k) {
+				cross[k] += std::conj(command[k]) * response[k];
+			}
+		}
+		++m_segments;
+	}
+
+	void WelchAccumulator::merge(WelchAccumulator const &other) {
+		for (std::size_t i = 0; i < m_power.size(); ++i) {
+			m_power[i] += other.m_power[i];
+		}
+		for (std::size_t i = 0; i < m_cross.size(); ++i) {
+			m_cross[i] += other.m_cross[i];
+		}
+		m_segments += other.m_segments;
+	}
+
+	double WelchAccumulator::psd(std::size_t channel, std::size_t k, double rateHz, std::vector<double> const &window) const {
+		double windowPower = 0;
+		for (std::size_t n = 0; n < window.size(); ++n) {
+			windowPower += window[n] * window[n];
+		}
+		/// every bin but DC and Nyquist also stands for its negative frequency
+		const double sides = (k == 0 || k == m_bins - 1) ? 1.0 : 2.0;
+		return sides * power(channel, k) / (rateHz * windowPower);
+	}
+
+	Complex WelchAccumulator::cross(std::size_t pair, std::size_t k) const {
+		return m_segments ? m_cross[pair * m_bins + k] / static_cast<double>(m_segments) : Complex();
+	}
+
+	double WelchAccumulator::power(std::size_t channel, std::size_t k) const {
+		return m_segments ? m_power[channel * m_bins + k] / m_segments : 0.0;
+	}
+
+	double WelchAccumulator::latency(Fft const &fft, std::size_t pair, std::size_t maxLag) const {
+		/// the cross-correlation is the inverse transform of the full,
+		/// conjugate-symmetric cross-spectrum
+		std::vector<Complex> spectrum(m_size);
+		for (std::size_t k = 0; k < m_bins; ++k) {
+			spectrum[k] = cross(pair, k);
+		}
+		for (std::size_t k = m_bins; k < m_size; ++k) {
+			spectrum[k] = std::conj(spectrum[m_size - k]);
+		}
+		fft.inverse(&spectrum[0]);
+		const std::ptrdiff_t limit = static_cast<std::ptrdiff_t>(std::min(maxLag, m_size / 2 - 1));
+		const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(m_size);
+		std::ptrdiff_t best = 0;
+		for (std::ptrdiff_t lag = -limit; lag <= limit; ++lag) {
+			if (spectrum[(lag + size) % size].real() > spectrum[(best + size) % size].real()) {
+				best = lag;
+			}
+		}
+		const double before = spectrum[(best - 1 + size) % size].real();
+		const double peak = spectrum[(best + size) % size].real();
+		const double after = spectrum[(best + 1) % size].real();
+		const double curvature = before - 2 * peak + after;
+		return best + (curvature < 0 ? 0.5 * (before - after) / curvature : 0.0);
+	}
+
+} // namespace motionplatform
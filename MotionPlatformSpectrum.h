@@ -0,0 +1,138 @@
+/** @file
+	@brief Radix-2 FFT and Welch spectral estimates for the analysis tool.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformSpectrum_h_GUID_5A9C14E3_7D2B_4F61_9E08_C3B6F24A8D17
+#define INCLUDED_MotionPlatformSpectrum_h_GUID_5A9C14E3_7D2B_4F61_9E08_C3B6F24A8D17
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace motionplatform {
+
+	typedef std::complex<double> Complex;
+
+	/// @brief In-place iterative radix-2 FFT of one fixed size.
+	///
+	/// The bit-reversal permutation and twiddle factors are computed once, so
+	/// a transform is only butterflies. A plan is read-only once built and can
+	/// be shared between threads.
+	class Fft : boost::noncopyable {
+	public:
+		/// @param size a power of two, at least 2
+		explicit Fft(std::size_t size);
+
+		std::size_t size() const { return m_size; }
+
+		/// @brief Forward transform (e^-i) of @p data, size() values.
+		void forward(Complex *data) const;
+
+		/// @brief Inverse transform of @p data, scaled by 1 / size().
+		void inverse(Complex *data) const;
+
+		/// @brief Spectra of two real sequences from a single complex
+		/// transform: @p a goes in the real and @p b in the imaginary part, and
+		/// the two are separated by symmetry. Writes bins 0 to size() / 2 of
+		/// each; @p scratch must hold size() values.
+		void forwardRealPair(const double *a, const double *b, Complex *scratch, Complex *outA, Complex *outB) const;
+
+	private:
+		void transform(Complex *data, bool inverse) const;
+
+		std::size_t m_size;
+		std::vector<std::size_t> m_reversed;
+		/// e^(-2 pi i k / size) for k < size / 2
+		std::vector<Complex> m_twiddles;
+	};
+
+	/// @brief Periodic Hann window of @p size points.
+	std::vector<double> hannWindow(std::size_t size);
+
+	/// @brief Averaged auto- and cross-spectra of a set of channels over
+	/// windowed segments (Welch's method).
+	///
+	/// Only the sums are kept, so memory does not grow with the length of the
+	/// input. Accumulators filled on different threads are combined with
+	/// merge().
+	class WelchAccumulator {
+	public:
+		/// @param pairs (command, response) channel indices to keep the
+		/// cross-spectrum of
+		WelchAccumulator(std::size_t channels, std::size_t segmentSize,
+			std::vector<std::pair<std::size_t, std::size_t> > const &pairs);
+
+		/// @brief Add one segment: @p segment holds segmentSize samples of
+		/// each channel, channel after channel. Each channel has its mean
+		/// removed and the window applied.
+		void add(Fft const &fft, std::vector<double> const &window, const double *segment);
+
+		void merge(WelchAccumulator const &other);
+
+		std::size_t segments() const { return m_segments; }
+
+		/// @brief One-sided power spectral density of @p channel at bin @p k
+		/// (units squared per Hz), for samples taken at @p rateHz with
+		/// @p window.
+		double psd(std::size_t channel, std::size_t k, double rateHz, std::vector<double> const &window) const;
+
+		/// Mean cross-spectrum conj(command) * response of @p pair at bin @p k.
+		Complex cross(std::size_t pair, std::size_t k) const;
+
+		/// Mean auto-spectrum |X|^2 of @p channel at bin @p k.
+		double power(std::size_t channel, std::size_t k) const;
+
+		/// @brief Lag (in samples, positive when the response trails the
+		/// command) of the peak of the cross-correlation of @p pair, within
+		/// +-@p maxLag samples and refined by a parabola through the peak.
+		double latency(Fft const &fft, std::size_t pair, std::size_t maxLag) const;
+
+		std::size_t bins() const { return m_bins; }
+		std::size_t pairCount() const { return m_pairs.size(); }
+
+	private:
+		std::size_t m_channels;
+		std::size_t m_size;
+		std::size_t m_bins;
+		std::vector<std::pair<std::size_t, std::size_t> > m_pairs;
+		std::size_t m_segments;
+		/// channel-major, m_bins values per channel / pair
+		std::vector<double> m_power;
+		std::vector<Complex> m_cross;
+		// per-segment scratch
+		std::vector<double> m_windowed;
+		std::vector<Complex> m_scratch;
+		std::vector<Complex> m_spectra;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformSpectrum_h_GUID_5A9C14E3_7D2B_4F61_9E08_C3B6F24A8D17
@@ -0,0 +1,259 @@
+/** @file
+	@brief Implementation of the runtime counters and their exporter.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformStats.h"
+
+// Library/third-party includes
+#include <boost/asio/deadline_timer.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/move/utility_core.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/ref.hpp>
+
+// Standard includes
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace motionplatform {
+
+	namespace {
+		const double BOUNDS_USEC[Histogram::BOUND_COUNT] = {
+			1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000
+		};
+
+		boost::uint64_t load(boost::atomic<boost::uint64_t> const &counter) {
+			return counter.load(boost::memory_order_relaxed);
+		}
+
+		void writeCounter(std::ostream &os, const char *name, const char *type,
+			const char *help, boost::uint64_t value) {
+			os << "# HELP " << name << " " << help << "\n"
+				<< "# TYPE " << name << " " << type << "\n"
+				<< name << " " << value << "\n";
+		}
+	} // namespace
+
+	const std::size_t Histogram::BOUND_COUNT;
+
+	Histogram::Histogram() : m_sumNsec(0) {
+		for (std::size_t i = 0; i <= BOUND_COUNT; ++i) {
+			m_buckets[i].store(0, boost::memory_order_relaxed);
+		}
+	}
+
+	void Histogram::observe(double usec) {
+		std::size_t bucket = 0;
+		while (bucket < BOUND_COUNT && usec > BOUNDS_USEC[bucket]) {
+			++bucket;
+		}
+		m_buckets[bucket].fetch_add(1, boost::memory_order_relaxed);
+		if (usec > 0) {
+			m_sumNsec.fetch_add(static_cast<boost::uint64_t>(usec * 1000.0), boost::memory_order_relaxed);
+		}
+	}
+
+	void Histogram::write(std::ostream &os, const char *name, const char *help) const {
+		os << "# HELP " << name << " " << help << "\n"
+			<< "# TYPE " << name << " histogram\n";
+		boost::uint64_t cumulative = 0;
+		for (std::size_t i = 0; i < BOUND_COUNT; ++i) {
+			cumulative += load(m_buckets[i]);
+			os << name << "_bucket{le=\"" << BOUNDS_USEC[i] << "\"} " << cumulative << "\n";
+		}
+		cumulative += load(m_buckets[BOUND_COUNT]);
+		os << name << "_bucket{le=\"+Inf\"} " << cumulative << "\n"
+			<< name << "_sum " << load(m_sumNsec) / 1000.0 << "\n"
+			<< name << "_count " << cumulative << "\n";
+	}
+
+	Stats::Stats()
+		: seats(0), ticks(0), samplesSent(0), coalescedTicks(0), stolenChunks(0),
+		tickMinorFaults(0), tickMajorFaults(0), replayPrefetched(0), replayMisses(0),
+		warmingUp(0), registerUsec(0), readyUsec(0) {}
+
+	void Stats::writePrometheus(std::ostream &os) const {
+		writeCounter(os, "motionplatform_seats", "gauge",
+			"Number of simulated seats.", load(seats));
+		writeCounter(os, "motionplatform_ticks_total", "counter",
+			"Simulation ticks completed.", load(ticks));
+		writeCounter(os, "motionplatform_samples_sent_total", "counter",
+			"Per-seat samples handed to OSVR.", load(samplesSent));
+		writeCounter(os, "motionplatform_coalesced_ticks_total", "counter",
+			"Ticks a seat skipped because it was not updated in time.", load(coalescedTicks));
+		writeCounter(os, "motionplatform_stolen_chunks_total", "counter",
+			"Seat chunks a scheduler worker took from another worker's run.", load(stolenChunks));
+		writeCounter(os, "motionplatform_tick_minor_faults_total", "counter",
+			"Minor page faults taken while updating, summed over the ticking thread and scheduler workers.", load(tickMinorFaults));
+		writeCounter(os, "motionplatform_tick_major_faults_total", "counter",
+			"Major page faults (disk reads) taken while updating, summed over the ticking thread and scheduler workers.", load(tickMajorFaults));
+		writeCounter(os, "motionplatform_replay_prefetched_blocks_total", "counter",
+			"Replay blocks the read-ahead thread had decoded in time.", load(replayPrefetched));
+		writeCounter(os, "motionplatform_replay_missed_blocks_total", "counter",
+			"Replay blocks the ticking thread had to read itself.", load(replayMisses));
+		writeCounter(os, "motionplatform_warming_up", "gauge",
+			"1 while the devices are registered but not yet simulating.", load(warmingUp));
+		writeCounter(os, "motionplatform_startup_register_microseconds", "gauge",
+			"Time taken to register the devices with the server.", load(registerUsec));
+		writeCounter(os, "motionplatform_startup_ready_microseconds", "gauge",
+			"Time from registering the devices until they were simulating.", load(readyUsec));
+		tickLateness.write(os, "motionplatform_tick_lateness_microseconds",
+			"How late each tick started relative to its deadline.");
+		tickUpdate.write(os, "motionplatform_tick_update_microseconds",
+			"Time spent updating the simulation for one tick.");
+		send.write(os, "motionplatform_send_microseconds",
+			"Time spent sending one seat's sample.");
+	}
+
+	void threadPageFaults(boost::uint64_t &minor, boost::uint64_t &major) {
+		minor = 0;
+		major = 0;
+#if defined(__linux__) && defined(RUSAGE_THREAD)
+		struct rusage usage;
+		if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+			minor = static_cast<boost::uint64_t>(usage.ru_minflt);
+			major = static_cast<boost::uint64_t>(usage.ru_majflt);
+		}
+#endif
+	}
+
+	StatsExporter::StatsExporter(StatsPtr const &stats, unsigned short port)
+		: m_stats(stats),
+		m_acceptor(m_io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port)),
+		m_socket(m_io) {
+		startAccept();
+		m_thread = boost::thread(boost::bind(&boost::asio::io_service::run, &m_io));
+	}
+
+	StatsExporter::~StatsExporter() {
+		m_io.stop();
+		m_thread.join();
+	}
+
+	unsigned short StatsExporter::port() const {
+		return m_acceptor.local_endpoint().port();
+	}
+
+	void StatsExporter::startAccept() {
+		m_acceptor.async_accept(m_socket,
+			boost::bind(&StatsExporter::handleAccept, this, boost::placeholders::_1));
+	}
+
+	namespace {
+
+		/// A scraper that has not sent its request (or read the answer) by
+		/// then is dropped.
+		const long CONNECTION_TIMEOUT_SEC = 5;
+
+		/// @brief One scrape: read the request head, answer with the metrics
+		/// and close, all asynchronously on the exporter's thread, so a slow
+		/// or silent client only holds up itself.
+		class Connection : public boost::enable_shared_from_this<Connection>, boost::noncopyable {
+		public:
+			Connection(boost::asio::io_service &io, boost::asio::ip::tcp::socket &socket, StatsPtr const &stats)
+				: m_socket(boost::move(socket)), m_timer(io), m_request(4096), m_stats(stats) {}
+
+			void start() {
+				m_timer.expires_from_now(boost::posix_time::seconds(CONNECTION_TIMEOUT_SEC));
+				m_timer.async_wait(boost::bind(&Connection::handleTimeout, shared_from_this(),
+					boost::placeholders::_1));
+				// the request itself is not parsed: every path returns the metrics
+				boost::asio::async_read_until(m_socket, m_request, "\r\n\r\n",
+					boost::bind(&Connection::handleRead, shared_from_this(), boost::placeholders::_1));
+			}
+
+		private:
+			void handleRead(boost::system::error_code const &error) {
+				// a head longer than the buffer, or cut short by the client
+				// shutting its side, still gets an answer
+				if (error && error != boost::asio::error::not_found && error != boost::asio::error::eof) {
+					close();
+					return;
+				}
+				std::ostringstream body;
+				m_stats->writePrometheus(body);
+				const std::string text = body.str();
+				std::ostringstream response;
+				response << "HTTP/1.0 200 OK\r\n"
+					"Content-Type: text/plain; version=0.0.4\r\n"
+					"Content-Length: " << text.size() << "\r\n"
+					"Connection: close\r\n\r\n" << text;
+				m_response = response.str();
+				boost::asio::async_write(m_socket, boost::asio::buffer(m_response),
+					boost::bind(&Connection::handleWrite, shared_from_this(), boost::placeholders::_1));
+			}
+
+			void handleWrite(boost::system::error_code const &) {
+				close();
+			}
+
+			void handleTimeout(boost::system::error_code const &error) {
+				if (error != boost::asio::error::operation_aborted) {
+					close();
+				}
+			}
+
+			/*
+			 * Cancels whatever is still pending, so the last handler lets go
+			 * of the connection
+			 */
+			void close() {
+				boost::system::error_code ignored;
+				m_timer.cancel(ignored);
+				m_socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+				m_socket.close(ignored);
+			}
+
+			boost::asio::ip::tcp::socket m_socket;
+			boost::asio::deadline_timer m_timer;
+			boost::asio::streambuf m_request;
+			std::string m_response;
+			StatsPtr m_stats;
+		};
+
+	} // namespace
+
+	/*
+	 * Hand the accepted socket to its own connection and wait for the next
+	 */
+	void StatsExporter::handleAccept(boost::system::error_code const &error) {
+		if (error == boost::asio::error::operation_aborted) {
+			return;
+		}
+		if (!error) {
+			boost::make_shared<Connection>(boost::ref(m_io), boost::ref(m_socket), m_stats)->start();
+		}
+		startAccept();
+	}
+
+} // namespace motionplatform
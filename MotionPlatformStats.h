@@ -0,0 +1,139 @@
+/** @file
+	@brief Lock-free runtime counters and a Prometheus text format exporter
+	serving them on a localhost TCP port.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformStats_h_GUID_71D2E8B5_4C09_4E3A_A6F7_0B5E9D3C2841
+#define INCLUDED_MotionPlatformStats_h_GUID_71D2E8B5_4C09_4E3A_A6F7_0B5E9D3C2841
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/asio.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <ostream>
+
+namespace motionplatform {
+
+	/// @brief Fixed-bucket histogram of microsecond durations.
+	///
+	/// Writers only do relaxed atomic increments, readers only relaxed loads,
+	/// so a scrape never blocks or slows down the thread being measured.
+	class Histogram : boost::noncopyable {
+	public:
+		/// Upper bounds in microseconds; one more bucket catches the rest.
+		static const std::size_t BOUND_COUNT = 13;
+
+		Histogram();
+
+		void observe(double usec);
+
+		void write(std::ostream &os, const char *name, const char *help) const;
+
+	private:
+		boost::atomic<boost::uint64_t> m_buckets[BOUND_COUNT + 1];
+		boost::atomic<boost::uint64_t> m_sumNsec;
+	};
+
+	/// @brief Counters updated from the tick and send path.
+	class Stats : boost::noncopyable {
+	public:
+		Stats();
+
+		/// @brief Count @p n more of something, relaxed.
+		static void add(boost::atomic<boost::uint64_t> &counter, boost::uint64_t n = 1) {
+			counter.fetch_add(n, boost::memory_order_relaxed);
+		}
+
+		/// @brief Serialize everything in Prometheus text exposition format.
+		void writePrometheus(std::ostream &os) const;
+
+		boost::atomic<boost::uint64_t> seats;
+		boost::atomic<boost::uint64_t> ticks;
+		boost::atomic<boost::uint64_t> samplesSent;
+		boost::atomic<boost::uint64_t> coalescedTicks;
+		boost::atomic<boost::uint64_t> stolenChunks;
+		/// Page faults taken while updating, by the ticking thread and every
+		/// scheduler worker together (see Scheduler::pageFaults).
+		boost::atomic<boost::uint64_t> tickMinorFaults;
+		boost::atomic<boost::uint64_t> tickMajorFaults;
+		/// Replay blocks the read-ahead had ready, and those the ticking
+		/// thread had to read itself.
+		boost::atomic<boost::uint64_t> replayPrefetched;
+		boost::atomic<boost::uint64_t> replayMisses;
+		/// 1 while the devices are registered but the simulation behind them
+		/// is still being built.
+		boost::atomic<boost::uint64_t> warmingUp;
+		/// Time taken to register the devices, and until they were ready.
+		boost::atomic<boost::uint64_t> registerUsec;
+		boost::atomic<boost::uint64_t> readyUsec;
+
+		/// How late each tick woke up relative to its deadline.
+		Histogram tickLateness;
+		/// Time spent updating the simulation for one tick.
+		Histogram tickUpdate;
+		/// Time spent sending one seat's sample.
+		Histogram send;
+	};
+
+	typedef boost::shared_ptr<Stats> StatsPtr;
+
+	/// @brief Page faults the calling thread has taken so far, from
+	/// getrusage(RUSAGE_THREAD). Both stay zero where that is not available.
+	/// Only counts this thread: see Scheduler::pageFaults for a whole tick.
+	void threadPageFaults(boost::uint64_t &minor, boost::uint64_t &major);
+
+	/// @brief Serves a Stats snapshot over HTTP on 127.0.0.1 from its own
+	/// thread. Any request on the port gets the current metrics. Requests
+	/// are served concurrently, and a client that stalls is dropped after a
+	/// few seconds without holding up the others.
+	class StatsExporter : boost::noncopyable {
+	public:
+		/// @throws boost::system::system_error if the port cannot be bound.
+		StatsExporter(StatsPtr const &stats, unsigned short port);
+		~StatsExporter();
+
+		unsigned short port() const;
+
+	private:
+		void startAccept();
+		void handleAccept(boost::system::error_code const &error);
+
+		StatsPtr m_stats;
+		boost::asio::io_service m_io;
+		boost::asio::ip::tcp::acceptor m_acceptor;
+		boost::asio::ip::tcp::socket m_socket;
+		boost::thread m_thread;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformStats_h_GUID_71D2E8B5_4C09_4E3A_A6F7_0B5E9D3C2841
@@ -0,0 +1,111 @@
+/** @file
+	@brief Implementation of the phase timeline recorder.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformTrace.h"
+
+// Library/third-party includes
+#include <boost/bind/bind.hpp>
+#include <boost/functional/hash.hpp>
+
+// Standard includes
+// - none
+
+namespace motionplatform {
+
+	Trace::Trace(std::string const &path, std::size_t capacity)
+		: m_file(std::fopen(path.c_str(), "w")), m_capacity(capacity ? capacity : 1),
+		m_events(new Event[m_capacity]), m_head(0), m_tail(0), m_dropped(0),
+		m_stopping(false), m_first(true), m_start(Clock::now()) {
+		if (!m_file) {
+			return;
+		}
+		for (std::size_t i = 0; i < m_capacity; ++i) {
+			m_events[i].sequence.store(0, boost::memory_order_relaxed);
+		}
+		std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", m_file);
+		m_flusher = boost::thread(boost::bind(&Trace::flushMain, this));
+	}
+
+	Trace::~Trace() {
+		if (!m_file) {
+			return;
+		}
+		m_stopping.store(true);
+		m_flusher.join();
+		drain();
+		std::fputs("\n]}\n", m_file);
+		std::fclose(m_file);
+	}
+
+	void Trace::record(const char *name, boost::uint64_t tick, boost::uint64_t beginNsec, boost::uint64_t endNsec) {
+		if (!m_file) {
+			return;
+		}
+		boost::uint64_t claim = m_head.load(boost::memory_order_relaxed);
+		do {
+			if (claim - m_tail.load(boost::memory_order_acquire) >= m_capacity) {
+				m_dropped.fetch_add(1, boost::memory_order_relaxed);
+				return;
+			}
+		} while (!m_head.compare_exchange_weak(claim, claim + 1, boost::memory_order_relaxed));
+
+		Event &e = m_events[claim % m_capacity];
+		e.name = name;
+		e.tick = tick;
+		e.beginNsec = beginNsec;
+		e.endNsec = endNsec;
+		e.thread = boost::hash<boost::thread::id>()(boost::this_thread::get_id()) % 100000;
+		e.sequence.store(claim + 1, boost::memory_order_release);
+	}
+
+	void Trace::flushMain() {
+		while (!m_stopping.load()) {
+			drain();
+			boost::this_thread::sleep_for(boost::chrono::milliseconds(20));
+		}
+	}
+
+	/*
+	 * Write out every event that is complete, in claim order
+	 */
+	void Trace::drain() {
+		boost::uint64_t tail = m_tail.load(boost::memory_order_relaxed);
+		for (;;) {
+			Event &e = m_events[tail % m_capacity];
+			if (e.sequence.load(boost::memory_order_acquire) != tail + 1) {
+				break;
+			}
+			std::fprintf(m_file,
+				"%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"tick\":%llu}}",
+				m_first ? "" : ",\n", e.name, static_cast<unsigned>(e.thread),
+				e.beginNsec / 1000.0, (e.endNsec - e.beginNsec) / 1000.0,
+				static_cast<unsigned long long>(e.tick));
+			m_first = false;
+			++tail;
+			m_tail.store(tail, boost::memory_order_release);
+		}
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,121 @@
+/** @file
+	@brief Optional per-tick phase timeline, recorded into a preallocated
+	buffer and flushed asynchronously as Chrome Trace Event JSON.
+
+	The output loads in chrome://tracing and in the Perfetto UI.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformTrace_h_GUID_0F8E3A6C_D25B_47C1_9B04_E7A1C6F3B852
+#define INCLUDED_MotionPlatformTrace_h_GUID_0F8E3A6C_D25B_47C1_9B04_E7A1C6F3B852
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <cstdio>
+#include <string>
+
+namespace motionplatform {
+
+	/// @brief Ring of completed phase events drained by a background thread.
+	///
+	/// Any thread may record. Recording claims a slot with one CAS and never
+	/// blocks or allocates; if the writer thread has fallen a full ring
+	/// behind, the event is dropped and counted instead.
+	class Trace : boost::noncopyable {
+	public:
+		typedef boost::chrono::steady_clock Clock;
+
+		Trace(std::string const &path, std::size_t capacity = 65536);
+		/// Drains whatever is left and closes the JSON document.
+		~Trace();
+
+		bool isOpen() const { return m_file != NULL; }
+
+		/// Nanoseconds since the trace started.
+		boost::uint64_t toNsec(Clock::time_point t) const {
+			return static_cast<boost::uint64_t>(
+				boost::chrono::duration_cast<boost::chrono::nanoseconds>(t - m_start).count());
+		}
+		boost::uint64_t now() const { return toNsec(Clock::now()); }
+
+		/// @brief Record a completed phase. @p name must be a string literal.
+		void record(const char *name, boost::uint64_t tick, boost::uint64_t beginNsec, boost::uint64_t endNsec);
+
+		boost::uint64_t dropped() const { return m_dropped.load(boost::memory_order_relaxed); }
+
+	private:
+		struct Event {
+			boost::atomic<boost::uint64_t> sequence; ///< claim index + 1 once written
+			const char *name;
+			boost::uint64_t tick;
+			boost::uint64_t beginNsec;
+			boost::uint64_t endNsec;
+			std::size_t thread;
+		};
+
+		void flushMain();
+		void drain();
+
+		std::FILE *m_file;
+		std::size_t m_capacity;
+		boost::scoped_array<Event> m_events;
+		boost::atomic<boost::uint64_t> m_head;
+		boost::atomic<boost::uint64_t> m_tail;
+		boost::atomic<boost::uint64_t> m_dropped;
+		boost::atomic<bool> m_stopping;
+		bool m_first;
+		Clock::time_point m_start;
+		boost::thread m_flusher;
+	};
+
+	/// @brief Records the lifetime of a scope as one phase, if tracing is on.
+	class TraceScope : boost::noncopyable {
+	public:
+		TraceScope(Trace *trace, const char *name, boost::uint64_t tick)
+			: m_trace(trace), m_name(name), m_tick(tick), m_begin(trace ? trace->now() : 0) {}
+		~TraceScope() {
+			if (m_trace) {
+				m_trace->record(m_name, m_tick, m_begin, m_trace->now());
+			}
+		}
+
+	private:
+		Trace *m_trace;
+		const char *m_name;
+		boost::uint64_t m_tick;
+		boost::uint64_t m_begin;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformTrace_h_GUID_0F8E3A6C_D25B_47C1_9B04_E7A1C6F3B852
@@ -0,0 +1,168 @@
+/** @file
+	@brief Implementation of the vibration bank.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MotionPlatformVibration.h"
+#include "MotionPlatformExpression.h"
+#include "MotionPlatformNoise.h"
+
+// Library/third-party includes
+#include <boost/math/constants/constants.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace motionplatform {
+
+	namespace {
+
+		const std::size_t MAX_VOICES = 64;
+
+	} // namespace
+
+	VibrationBank::VibrationBank(std::size_t seatCount, double rateHz, boost::uint32_t seed)
+		: m_seatCount(seatCount), m_rateHz(rateHz), m_seed(seed) {}
+
+	bool VibrationBank::addVoice(std::string const &spec, std::string &error) {
+		std::istringstream is(spec);
+		std::string name, kind;
+		is >> name >> kind;
+		const int channel = channelIndex(name);
+		if (channel < 0) {
+			error = "unknown channel '" + name + "'";
+			return false;
+		}
+		double frequency = 0, level = 0, q = 0;
+		if (kind == "sine") {
+			is >> frequency >> level;
+		} else if (kind == "noise") {
+			is >> frequency >> q >> level;
+		} else {
+			error = "unknown voice '" + kind + "'";
+			return false;
+		}
+		std::string extra;
+		if (is.fail() || (is >> extra)) {
+			error = "wrong arguments for " + kind;
+			return false;
+		}
+		if (!(frequency > 0 && frequency * 2 < m_rateHz)) {
+			error = "frequency must be within (0, rate / 2)";
+			return false;
+		}
+		if (kind == "noise" && !(q > 0)) {
+			error = "q must be positive";
+			return false;
+		}
+		if (!(level >= 0 && level <= 1)) {
+			error = "amplitude must be within [0, 1]";
+			return false;
+		}
+		if (m_voices.size() >= MAX_VOICES) {
+			error = "too many vibration voices";
+			return false;
+		}
+
+		const double w0 = 2 * boost::math::constants::pi<double>() * frequency / m_rateHz;
+		Voice voice = Voice();
+		voice.channel = static_cast<std::size_t>(channel);
+		voice.noise = kind == "noise";
+		/// every voice gets its own seeder so adding one does not change the others
+		boost::mt19937 seeder(m_seed + static_cast<boost::uint32_t>(m_voices.size()));
+		std::vector<float> s0(m_seatCount), s1(m_seatCount);
+		std::vector<boost::uint32_t> rng(m_seatCount);
+		if (voice.noise) {
+			const BandPass bandPass = BandPass::design(frequency, q, m_rateHz);
+			voice.c0 = bandPass.b0;
+			voice.c1 = bandPass.b2;
+			voice.c2 = bandPass.a1;
+			voice.c3 = bandPass.a2;
+			voice.gain = static_cast<float>(level / bandPass.whiteNoiseRms(seedLane(seeder())));
+			for (std::size_t i = 0; i < m_seatCount; ++i) {
+				rng[i] = seedLane(seeder());
+			}
+		} else {
+			voice.gain = static_cast<float>(level);
+			voice.c0 = static_cast<float>(std::cos(w0));
+			voice.c1 = static_cast<float>(std::sin(w0));
+			/// random starting phase per seat so the seats do not buzz in step
+			const double scale = 2 * boost::math::constants::pi<double>() / 4294967296.0;
+			for (std::size_t i = 0; i < m_seatCount; ++i) {
+				const double phase = seeder() * scale;
+				s0[i] = static_cast<float>(std::cos(phase));
+				s1[i] = static_cast<float>(std::sin(phase));
+			}
+		}
+
+		m_voices.push_back(voice);
+		if (std::find(m_channels.begin(), m_channels.end(), voice.channel) == m_channels.end()) {
+			m_channels.push_back(voice.channel);
+		}
+		m_s0.insert(m_s0.end(), s0.begin(), s0.end());
+		m_s1.insert(m_s1.end(), s1.begin(), s1.end());
+		m_rng.insert(m_rng.end(), rng.begin(), rng.end());
+		return true;
+	}
+
+	void VibrationBank::mix(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount) {
+		for (std::size_t v = 0; v < m_voices.size(); ++v) {
+			const Voice &voice = m_voices[v];
+			float *out = actuators + voice.channel * seatCount;
+			float *s0 = &m_s0[v * m_seatCount];
+			float *s1 = &m_s1[v * m_seatCount];
+			if (voice.noise) {
+				boost::uint32_t *rng = &m_rng[v * m_seatCount];
+				// transposed direct form II, b1 is zero
+				for (std::size_t i = begin; i < end; ++i) {
+					const float w = fastNormal(rng[i]);
+					const float y = voice.c0 * w + s0[i];
+					s0[i] = s1[i] - voice.c2 * y;
+					s1[i] = voice.c1 * w - voice.c3 * y;
+					out[i] += voice.gain * y;
+				}
+			} else {
+				for (std::size_t i = begin; i < end; ++i) {
+					const float re = s0[i] * voice.c0 - s1[i] * voice.c1;
+					const float im = s0[i] * voice.c1 + s1[i] * voice.c0;
+					/// one Newton step towards unit length stops rounding from
+					/// growing or shrinking the phasor
+					const float k = 1.5f - 0.5f * (re * re + im * im);
+					s0[i] = re * k;
+					s1[i] = im * k;
+					out[i] += voice.gain * s1[i];
+				}
+			}
+		}
+		for (std::size_t c = 0; c < m_channels.size(); ++c) {
+			float *out = actuators + m_channels[c] * seatCount;
+			for (std::size_t i = begin; i < end; ++i) {
+				out[i] = std::max(-1.0f, std::min(1.0f, out[i]));
+			}
+		}
+	}
+
+} // namespace motionplatform
@@ -0,0 +1,103 @@
+/** @file
+	@brief Vibration layer: a bank of oscillator and noise voices mixed on
+	top of the actuator channels.
+
+	@date 2026
+
+	@author
+	VectionVR
+	<http://vectionvr.blogspot.com>
+	*/
+
+// Copyright 2026 VectionVR
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MotionPlatformVibration_h_GUID_B4E82A57_3C19_4F6D_8A02_E5D7F19C3B46
+#define INCLUDED_MotionPlatformVibration_h_GUID_B4E82A57_3C19_4F6D_8A02_E5D7F19C3B46
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace motionplatform {
+
+	/// @brief Superimposes high-frequency vibration (engine, road texture) on
+	/// the low-frequency motion cue of every seat.
+	///
+	/// Each voice adds to one actuator channel and is given as one of
+	///
+	///     <channel> sine <hz> <amplitude>
+	///     <channel> noise <center hz> <q> <rms>
+	///
+	/// e.g. "target_displacement.z sine 35 0.05". Every seat runs every voice
+	/// with its own state (a random starting phase, or its own noise stream),
+	/// stored voice-major one array per field. A sine voice is a phasor
+	/// rotated by a fixed complex factor each tick, so it costs a few
+	/// multiplies per seat and no trigonometry; a noise voice is fastNormal()
+	/// through a band-pass biquad. Each voice is one straight loop over the
+	/// seats, so the cost grows linearly with voices. Mixed channels are
+	/// clamped to [-1, 1].
+	class VibrationBank : boost::noncopyable {
+	public:
+		/// @param rateHz tick rate the voices are designed for
+		VibrationBank(std::size_t seatCount, double rateHz, boost::uint32_t seed = 5489u);
+
+		/// @brief Add the voice described by @p spec. Must not be called
+		/// during a mix.
+		/// @return false, with @p error set and the bank unchanged, if @p spec
+		/// is invalid.
+		bool addVoice(std::string const &spec, std::string &error);
+
+		std::size_t voiceCount() const { return m_voices.size(); }
+
+		/// @brief Advance every voice by one tick for seats [begin, end) and
+		/// add it to the channel-major @p actuators array. Disjoint ranges may
+		/// be mixed concurrently.
+		void mix(std::size_t begin, std::size_t end, float *actuators, std::size_t seatCount);
+
+	private:
+		struct Voice {
+			std::size_t channel;
+			bool noise;
+			/// sine: amplitude, noise: calibrated gain
+			float gain;
+			/// sine: rotation cos/sin, noise: biquad b0, b2, a1, a2
+			float c0, c1, c2, c3;
+		};
+
+		std::size_t m_seatCount;
+		double m_rateHz;
+		boost::uint32_t m_seed;
+		std::vector<Voice> m_voices;
+		/// channels any voice adds to, clamped after mixing
+		std::vector<std::size_t> m_channels;
+
+		// per seat and voice state, index = voice * seatCount + seat;
+		// sine: phasor real/imaginary part, noise: biquad state
+		std::vector<float> m_s0;
+		std::vector<float> m_s1;
+		std::vector<boost::uint32_t> m_rng;
+	};
+
+} // namespace motionplatform
+
+#endif // INCLUDED_MotionPlatformVibration_h_GUID_B4E82A57_3C19_4F6D_8A02_E5D7F19C3B46
@@ -26,127 +26,736 @@
 // Internal Includes
 #include <osvr/PluginKit/PluginKit.h>
 #include <osvr/PluginKit/TrackerInterfaceC.h>
+#include <osvr/PluginKit/AnalogInterfaceC.h>
+#include "MotionPlatformCallLog.h"
+#include "MotionPlatformConfig.h"
+#include "MotionPlatformNoise.h"
+#include "MotionPlatformProbes.h"
+#include "MotionPlatformReplay.h"
+#include "MotionPlatformScheduler.h"
+#include "MotionPlatformScript.h"
+#include "MotionPlatformSignal.h"
+#include "MotionPlatformStats.h"
+#include "MotionPlatformVibration.h"
 
-// Generated JSON header file
-#include "com_vectionvr_osvr_motionPlatformDevicePlugin_json.h"
+// Generated channel layout of the JSON descriptor
+#include "com_vectionvr_osvr_motionPlatformDevicePlugin_layout.h"
 #include <boost/thread/thread.hpp>
-#include <boost/math/constants/constants.hpp>
-#include <boost/random.hpp>
-#include <boost/generator_iterator.hpp>
+#include <boost/algorithm/string/join.hpp>
+#include <boost/atomic.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/chrono.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/static_assert.hpp>
 
 // Library/third-party includes
 // - none
 
 // Standard includes
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <exception>
 #include <iostream>
-
-typedef boost::mt19937 RNGType;
-typedef boost::uniform_int<int> DistributionType;
+#include <map>
+#include <string>
 
 // Anonymous namespace to avoid symbol collision
 namespace {
 
+	typedef boost::chrono::steady_clock Clock;
+
+	inline double toUsec(Clock::duration d) {
+		return boost::chrono::duration<double, boost::micro>(d).count();
+	}
+
+	/// Time between two simulation ticks at @p rateHz
+	inline Clock::duration tickPeriod(double rateHz) {
+		return boost::chrono::microseconds(static_cast<boost::int64_t>(std::floor(1.0e6 / rateHz + 0.5)));
+	}
+
+	/// @brief Everything the seats of one platform share
+	///
+	/// The devices are registered before the simulation behind them exists:
+	/// a background thread builds the scheduler and everything that drives
+	/// the channels, then sets @c ready. Until then only @c config, @c calls,
+	/// @c stats and @c exporter may be used.
+	struct Platform {
+		Platform() : ready(false) {}
+		/// the seats are deleted by the server, possibly before warming up is done
+		~Platform() {
+			if (warmup.joinable()) {
+				warmup.join();
+			}
+		}
+
+		/// declared first so they outlive the seats and the scheduler's workers
+		boost::scoped_ptr<motionplatform::CallLogWriter> calls;
+		boost::scoped_ptr<motionplatform::Trace> trace;
+		boost::scoped_ptr<motionplatform::NoiseGenerator> noise;
+		boost::scoped_ptr<motionplatform::ScriptPlayer> scripts;
+		boost::scoped_ptr<motionplatform::ReplayPlayer> replay;
+		boost::scoped_ptr<motionplatform::SignalGenerator> signals;
+		boost::scoped_ptr<motionplatform::VibrationBank> vibration;
+		boost::scoped_ptr<motionplatform::ExpressionSet> expressions;
+		motionplatform::ConfigStorePtr config;
+		motionplatform::SchedulerPtr scheduler;
+		motionplatform::StatsPtr stats;
+		/// declared after the stats so it stops before they go away
+		boost::scoped_ptr<motionplatform::StatsExporter> exporter;
+		/// builds what the seats need to simulate (see warmUp)
+		boost::thread warmup;
+		/// set, with release ordering, once the scheduler and everything it
+		/// drives is in place
+		boost::atomic<bool> ready;
+	};
+	typedef boost::shared_ptr<Platform> PlatformPtr;
+
+	/*
+	 * Start the script each seat has under @p config, leaving the seats whose
+	 * script is the same as under @p previous (if any) undisturbed
+	 */
+	void assignScripts(motionplatform::ScriptPlayer &player, std::size_t seatCount,
+		motionplatform::Config const &config, motionplatform::Config const *previous) {
+		/// seats sharing a script text share one parsed copy
+		std::map<std::string, motionplatform::ScriptPtr> parsed;
+		for (std::size_t seat = 0; seat < seatCount; ++seat) {
+			std::string const &text = motionplatform::seatScript(config, seat);
+			if (previous && motionplatform::seatScript(*previous, seat) == text) {
+				continue;
+			}
+			motionplatform::ScriptPtr &script = parsed[text];
+			if (!script && !text.empty()) {
+				boost::shared_ptr<motionplatform::Script> fresh = boost::make_shared<motionplatform::Script>();
+				std::string error;
+				if (!motionplatform::parseScript(text, *fresh, error)) {
+					// loadConfig already rejects these
+					std::cerr << "MPS_PLUGIN > Seat " << seat << " script: " << error << std::endl;
+					continue;
+				}
+				script = fresh;
+			}
+			player.assign(seat, script);
+		}
+	}
+
+	/*
+	 * Switch to the colored noise of @p config, designed for its tick rate;
+	 * only call between ticks
+	 */
+	void setNoise(Platform &platform, motionplatform::Config const &config) {
+		motionplatform::Simulation &sim = platform.scheduler->simulation();
+		boost::scoped_ptr<motionplatform::NoiseGenerator> noise;
+		if (!config.noise.empty()) {
+			noise.reset(new motionplatform::NoiseGenerator(sim.seatCount(), config.rateHz));
+			std::string error;
+			if (!noise->configure(config.noise, error)) {
+				// loadConfig already rejects these
+				std::cerr << "MPS_PLUGIN > noise: " << error << std::endl;
+				return;
+			}
+		}
+		sim.setNoise(noise.get());
+		platform.noise.swap(noise);
+	}
+
+	/*
+	 * Open the recording @p config replays if it differs from @p previous's
+	 * (if any), then apply its seek position if that changed, its speed and
+	 * its loop region; only call between ticks
+	 */
+	void setReplay(Platform &platform, motionplatform::Config const &config, motionplatform::Config const *previous) {
+		motionplatform::Simulation &sim = platform.scheduler->simulation();
+		if (!previous || config.replay != previous->replay || config.replayReadAhead != previous->replayReadAhead) {
+			boost::scoped_ptr<motionplatform::ReplayPlayer> replay;
+			if (!config.replay.empty()) {
+				replay.reset(new motionplatform::ReplayPlayer(config.replay, sim.seatCount(), config.replayReadAhead));
+				if (replay->isOpen()) {
+					replay->seek(config.replaySeek);
+				} else {
+					std::cerr << "MPS_PLUGIN > Could not replay " << boost::algorithm::join(config.replay, ", ") << std::endl;
+					replay.reset();
+				}
+			}
+			sim.setReplay(replay.get());
+			platform.replay.swap(replay);
+		} else if (platform.replay && config.replaySeek != previous->replaySeek) {
+			platform.replay->seek(config.replaySeek);
+		}
+		if (platform.replay) {
+			platform.replay->setSpeed(config.replaySpeed);
+			platform.replay->setLoop(config.replayLoopBegin, config.replayLoopEnd);
+		}
+	}
+
+	/*
+	 * Start the test signals of @p config from their first sample; only call
+	 * between ticks
+	 */
+	void setSignals(Platform &platform, motionplatform::Config const &config) {
+		motionplatform::Simulation &sim = platform.scheduler->simulation();
+		boost::scoped_ptr<motionplatform::SignalGenerator> signals(new motionplatform::SignalGenerator());
+		std::string error;
+		if (!motionplatform::buildSignals(config, *signals, error)) {
+			// loadConfig already rejects these
+			std::cerr << "MPS_PLUGIN > " << error << std::endl;
+			return;
+		}
+		if (signals->empty()) {
+			signals.reset();
+		}
+		sim.setSignals(signals.get());
+		platform.signals.swap(signals);
+	}
+
+	/*
+	 * Start the vibration voices of @p config, designed for its tick rate;
+	 * only call between ticks
+	 */
+	void setVibration(Platform &platform, motionplatform::Config const &config) {
+		motionplatform::Simulation &sim = platform.scheduler->simulation();
+		boost::scoped_ptr<motionplatform::VibrationBank> vibration(
+			new motionplatform::VibrationBank(sim.seatCount(), config.rateHz));
+		std::string error;
+		if (!motionplatform::buildVibration(config, *vibration, error)) {
+			// loadConfig already rejects these
+			std::cerr << "MPS_PLUGIN > " << error << std::endl;
+			return;
+		}
+		if (vibration->voiceCount() == 0) {
+			vibration.reset();
+		}
+		sim.setVibration(vibration.get());
+		platform.vibration.swap(vibration);
+	}
+
+	/*
+	 * Compile the channel expressions of @p config and have the simulation use
+	 * them; only call between ticks
+	 */
+	void setExpressions(Platform &platform, motionplatform::Config const &config) {
+		motionplatform::Simulation &sim = platform.scheduler->simulation();
+		boost::scoped_ptr<motionplatform::ExpressionSet> expressions(new motionplatform::ExpressionSet());
+		std::string error;
+		if (!motionplatform::buildExpressions(config, *expressions, error)) {
+			// loadConfig already rejects these
+			std::cerr << "MPS_PLUGIN > " << error << std::endl;
+			return;
+		}
+		if (expressions->empty()) {
+			expressions.reset();
+		}
+		sim.setExpressions(expressions.get());
+		platform.expressions.swap(expressions);
+	}
+
+	/// @brief Copies @p Count values with the loop unrolled at compile time
+	template <unsigned Count>
+	struct CopyChannels {
+		static void apply(OSVR_AnalogState *dst, const double *src) {
+			CopyChannels<Count - 1>::apply(dst, src);
+			dst[Count - 1] = src[Count - 1];
+		}
+	};
+	template <>
+	struct CopyChannels<0> {
+		static void apply(OSVR_AnalogState *, const double *) {}
+	};
+
+	/// @brief Thin per-seat handle: all simulation state lives in the shared
+	/// motionplatform::Simulation, this class only sends one seat to OSVR.
+	/// The scheduler spreads the per-tick update over its worker pool.
+	///
+	/// The device registers its interfaces and descriptor as soon as it is
+	/// constructed. Until the platform has warmed up it sends the rest pose
+	/// once, with sample_sequence 0, and then nothing.
+	///
+	/// @tparam Layout channel layout of the JSON descriptor, generated from it
+	/// at build time (see MotionPlatformLayout.cmake). A descriptor that does
+	/// not match what the simulation produces fails to compile.
+	template <typename Layout>
 	class TrackerSyncDevice {
+		static const unsigned AXES = 3;
+		BOOST_STATIC_ASSERT_MSG(Layout::TRACKER_COUNT == 1,
+			"the descriptor must declare exactly one tracker per seat");
+		BOOST_STATIC_ASSERT_MSG(Layout::ANALOG_COUNT == motionplatform::Simulation::ACTUATOR_COUNT + 1,
+			"the descriptor must declare the actuator channels plus the sequence channel");
+		BOOST_STATIC_ASSERT_MSG(Layout::TARGET_DISPLACEMENT_CHANNEL + AXES <= Layout::ANALOG_COUNT &&
+			Layout::TARGET_ANGLE_CHANNEL + AXES <= Layout::ANALOG_COUNT &&
+			Layout::SEQUENCE_CHANNEL < Layout::ANALOG_COUNT,
+			"semantic channels must lie within the declared analog count");
+		BOOST_STATIC_ASSERT_MSG(Layout::TARGET_DISPLACEMENT_CHANNEL + AXES <= Layout::TARGET_ANGLE_CHANNEL ||
+			Layout::TARGET_ANGLE_CHANNEL + AXES <= Layout::TARGET_DISPLACEMENT_CHANNEL,
+			"target_displacement and target_angle must not overlap");
+		BOOST_STATIC_ASSERT_MSG((Layout::SEQUENCE_CHANNEL < Layout::TARGET_DISPLACEMENT_CHANNEL ||
+			Layout::SEQUENCE_CHANNEL >= Layout::TARGET_DISPLACEMENT_CHANNEL + AXES) &&
+			(Layout::SEQUENCE_CHANNEL < Layout::TARGET_ANGLE_CHANNEL ||
+			Layout::SEQUENCE_CHANNEL >= Layout::TARGET_ANGLE_CHANNEL + AXES),
+			"sample_sequence must not overlap the actuator channels");
+		// the simulation fills the channels in this order, whatever the JSON
+		// descriptor (which motionplatform::buildDescriptor patches) declares
+		BOOST_STATIC_ASSERT_MSG(Layout::ORIENTATION_SENSOR == 0 &&
+			Layout::TARGET_DISPLACEMENT_CHANNEL == 0 &&
+			Layout::TARGET_ANGLE_CHANNEL == motionplatform::Simulation::TARGET_ANGLE_CHANNEL &&
+			Layout::SEQUENCE_CHANNEL == motionplatform::Simulation::ACTUATOR_COUNT,
+			"the JSON descriptor and motionplatform::Simulation disagree on the channels");
+		/// turning the sequence off drops the last channel, so it must be last
+		BOOST_STATIC_ASSERT(Layout::SEQUENCE_CHANNEL == Layout::ANALOG_COUNT - 1);
+		/// the call log takes poses and analog values as they are sent
+		BOOST_STATIC_ASSERT(sizeof(OSVR_PoseState) == motionplatform::CALL_POSE_VALUES * sizeof(double));
+		BOOST_STATIC_ASSERT(sizeof(OSVR_AnalogState) == sizeof(double));
+
 	public:
-		TrackerSyncDevice(OSVR_PluginRegContext ctx) {
+		TrackerSyncDevice(OSVR_PluginRegContext ctx, PlatformPtr const &platform, std::size_t seat)
+			: m_platform(platform), m_sim(NULL), m_warm(false), m_restSent(false),
+			m_stats(*platform->stats), m_seat(seat), m_lastTick(0), m_deadline(Clock::now()),
+			m_configGeneration(platform->config->generation()) {
+			motionplatform::ConfigStore::ConfigPtr config = platform->config->get();
+			applyConfig(*config);
+			m_motionConfig = config;
+			/// Build the descriptor once; it is only rebuilt when the config changes
+			m_descriptor = motionplatform::buildDescriptor(*config, seat);
 			/// Create the initialization options
 			OSVR_DeviceInitOptions opts = osvrDeviceCreateInitOptions(ctx);
 			// configure device tracker
 			osvrDeviceTrackerConfigure(opts, &m_tracker);
+			// configure device analogs (target displacement and target angle)
+			osvrDeviceAnalogConfigure(opts, &m_analog, Layout::ANALOG_COUNT);
 			/// Create the sync device token with the options
-			m_dev.initSync(ctx, "SyncMotionPlatformDevice", opts);
+			m_dev.initSync(ctx, deviceName(seat).c_str(), opts);
 			/// Send JSON descriptor
-			m_dev.sendJsonDescriptor(com_vectionvr_osvr_motionPlatformDevicePlugin_json);
+			m_dev.sendJsonDescriptor(m_descriptor);
+			if (motionplatform::CallLogWriter *calls = m_platform->calls.get()) {
+				calls->descriptor(m_seat, m_descriptor.data(), m_descriptor.size());
+			}
 			/// Register update callback
 			m_dev.registerUpdateCallback(this);
 		}
 
 		OSVR_ReturnCode update() {
+			if (!m_warm) {
+				if (!m_platform->ready.load(boost::memory_order_acquire)) {
+					sendRest();
+					return OSVR_RETURN_SUCCESS;
+				}
+				warmedUp();
+			}
+			if (m_platform->config->generation() != m_configGeneration) {
+				reconfigure();
+			}
+			/// the first seat paces the simulation, the others follow its ticks
+			if (m_seat == 0) {
+				tick();
+			}
+			const boost::uint64_t current = m_sim->tick();
+			if (current == m_lastTick) {
+				return OSVR_RETURN_SUCCESS;
+			}
+			if (m_lastTick != 0 && current - m_lastTick > 1) {
+				motionplatform::Stats::add(m_stats.coalescedTicks, current - m_lastTick - 1);
+			}
+			m_lastTick = current;
+			Clock::time_point sendStart = Clock::now();
+			motionplatform::TraceScope sendScope(m_platform->trace.get(), "send", current);
+
 			/// initialise pose
 			osvrPose3SetIdentity(&pose);
-			/// update quaternion with random values
-			updatePoseOrientation(getRandomFloat(-45.0f, 45.0f), getRandomFloat(-45.0f, 45.0f), getRandomFloat(-45.0f, 45.0f));
+			/// copy this seat's orientation out of the simulation
+			double quat[4];
+			m_sim->getOrientation(m_seat, quat);
+			osvrQuatSetX(&(pose.rotation), quat[0]);
+			osvrQuatSetY(&(pose.rotation), quat[1]);
+			osvrQuatSetZ(&(pose.rotation), quat[2]);
+			osvrQuatSetW(&(pose.rotation), quat[3]);
 			/// send pose to listeners
-			osvrDeviceTrackerSendPose(m_dev, m_tracker, &pose, 0);
+			osvrDeviceTrackerSendPose(m_dev, m_tracker, &pose, Layout::ORIENTATION_SENSOR);
+			motionplatform::CallLogWriter *calls = m_platform->calls.get();
+			if (calls) {
+				calls->pose(m_seat, Layout::ORIENTATION_SENSOR, reinterpret_cast<const double *>(&pose));
+			}
+			MOTIONPLATFORM_PROBE_POSE_SENT(m_seat, current);
+			/// send actuator targets to listeners, tagged with the tick they
+			/// belong to so clients can spot dropped or coalesced samples
+			double actuators[motionplatform::Simulation::ACTUATOR_COUNT];
+			m_sim->getActuators(m_seat, actuators);
+			CopyChannels<AXES>::apply(m_analogValues + Layout::TARGET_DISPLACEMENT_CHANNEL, actuators);
+			CopyChannels<AXES>::apply(m_analogValues + Layout::TARGET_ANGLE_CHANNEL,
+				actuators + motionplatform::Simulation::TARGET_ANGLE_CHANNEL);
+			m_analogValues[Layout::SEQUENCE_CHANNEL] = static_cast<OSVR_AnalogState>(m_lastTick);
+			osvrDeviceAnalogSetValues(m_dev, m_analog, m_analogValues, m_analogCount);
+			if (calls) {
+				calls->analog(m_seat, m_analogValues, m_analogCount);
+			}
+			MOTIONPLATFORM_PROBE_ANALOG_SENT(m_seat, current);
+			m_stats.send.observe(toUsec(Clock::now() - sendStart));
+			motionplatform::Stats::add(m_stats.samplesSent);
 #ifdef _DEBUG
 			std::cout << "MPS_PLUGIN > Sending update" << pose.rotation << std::endl;
 #endif
-			boost::this_thread::sleep(boost::posix_time::milliseconds(1000));
 			return OSVR_RETURN_SUCCESS;
 		}
-	
-	// random number generator properties
+
+	// simulation related variables
 	private:
-		RNGType rng;
-	
+		PlatformPtr m_platform;
+		/// NULL until the platform has warmed up
+		const motionplatform::Simulation *m_sim;
+		bool m_warm;
+		bool m_restSent;
+		motionplatform::Stats &m_stats;
+		std::size_t m_seat;
+		boost::uint64_t m_lastTick;
+		/// when the next tick is due (first seat only)
+		Clock::time_point m_deadline;
+		Clock::duration m_period;
+		/// config generation the descriptor and settings below were built from
+		boost::uint64_t m_configGeneration;
+		std::string m_descriptor;
+		/// config the running noise, scripts, replay, signals, vibration and
+		/// expressions come from
+		/// (first seat only)
+		motionplatform::ConfigStore::ConfigPtr m_motionConfig;
+		/// analog channels currently published (the sequence channel is optional)
+		OSVR_ChannelCount m_analogCount;
+
 	// OSVR related variables
 	private:
 		osvr::pluginkit::DeviceToken m_dev;
 		OSVR_TrackerDeviceInterface m_tracker;
+		OSVR_AnalogDeviceInterface m_analog;
 		OSVR_PoseState pose;
-	
+		OSVR_AnalogState m_analogValues[Layout::ANALOG_COUNT];
+
 	// private methods
 	private:
-		int getRandomFloat(float min, float max){
-			DistributionType u(min, max);
-			boost::variate_generator<RNGType&, DistributionType > gen(rng, u);
-			return gen();
+		/*
+		 * Send the rest pose and actuator targets once, tagged with sequence 0
+		 * (no tick), so listeners see the device before it simulates
+		 */
+		void sendRest() {
+			if (m_restSent) {
+				return;
+			}
+			m_restSent = true;
+			osvrPose3SetIdentity(&pose);
+			osvrDeviceTrackerSendPose(m_dev, m_tracker, &pose, Layout::ORIENTATION_SENSOR);
+			std::fill(m_analogValues, m_analogValues + Layout::ANALOG_COUNT, OSVR_AnalogState(0));
+			osvrDeviceAnalogSetValues(m_dev, m_analog, m_analogValues, m_analogCount);
+			if (motionplatform::CallLogWriter *calls = m_platform->calls.get()) {
+				calls->pose(m_seat, Layout::ORIENTATION_SENSOR, reinterpret_cast<const double *>(&pose));
+				calls->analog(m_seat, m_analogValues, m_analogCount);
+			}
 		}
+
 		/*
-		 * Update pose with provided values
+		 * Start simulating: the scheduler exists now, and the first seat's
+		 * deadlines count from here rather than from registration
 		 */
-		void updatePoseOrientation(float pitch, float yaw, float roll)
-		{
-			// Basically we create 3 Quaternions, one for pitch, one for yaw, one for roll
-			// and multiply those together.
-			// the calculation below does the same, just shorter
-
-			float p = pitch * (boost::math::constants::pi<float>() /180) / 2.0;
-			float y = yaw * (boost::math::constants::pi<float>() / 180) / 2.0;
-			float r = roll * (boost::math::constants::pi<float>() / 180) / 2.0;
-
-			float sinp = sin(p);
-			float siny = sin(y);
-			float sinr = sin(r);
-			float cosp = cos(p);
-			float cosy = cos(y);
-			float cosr = cos(r);
-
-			osvrQuatSetX(&(pose.rotation), sinr * cosp * cosy - cosr * sinp * siny);
-			osvrQuatSetY(&(pose.rotation), cosr * sinp * cosy + sinr * cosp * siny);
-			osvrQuatSetZ(&(pose.rotation), cosr * cosp * siny - sinr * sinp * cosy);
-			osvrQuatSetW(&(pose.rotation), cosr * cosp * cosy + sinr * sinp * siny);
+		void warmedUp() {
+			m_warm = true;
+			m_sim = &m_platform->scheduler->simulation();
+			m_deadline = Clock::now();
+		}
+
+		/*
+		 * Wait for the next deadline and advance every seat by one tick
+		 */
+		void tick() {
+			const Clock::duration period = m_period;
+			motionplatform::Trace *trace = m_platform->trace.get();
+			const boost::uint64_t next = m_sim->tick() + 1;
+			m_deadline += period;
+			Clock::time_point sleepStart = Clock::now();
+			boost::this_thread::sleep_until(m_deadline);
+			Clock::time_point wake = Clock::now();
+			m_stats.tickLateness.observe(toUsec(wake - m_deadline));
+			if (trace) {
+				trace->record("sleep", next, trace->toNsec(sleepStart), trace->toNsec(std::min(m_deadline, wake)));
+				if (wake > m_deadline) {
+					trace->record("wake", next, trace->toNsec(m_deadline), trace->toNsec(wake));
+				}
+			}
+			if (wake - m_deadline > period) {
+				// fell more than a tick behind: skip ahead rather than burst
+				m_deadline = wake;
+			}
+			/// returns once every worker has finished the tick
+			motionplatform::Scheduler &scheduler = *m_platform->scheduler;
+			boost::uint64_t minorBefore, majorBefore, minorAfter, majorAfter;
+			scheduler.pageFaults(minorBefore, majorBefore);
+			{
+				motionplatform::TraceScope scope(trace, "update", next);
+				scheduler.step(boost::chrono::duration<double>(period).count());
+			}
+			scheduler.pageFaults(minorAfter, majorAfter);
+			m_stats.tickUpdate.observe(toUsec(Clock::now() - wake));
+			motionplatform::Stats::add(m_stats.ticks);
+			motionplatform::Stats::add(m_stats.tickMinorFaults, minorAfter - minorBefore);
+			motionplatform::Stats::add(m_stats.tickMajorFaults, majorAfter - majorBefore);
+			m_stats.stolenChunks.store(scheduler.stolenChunks(), boost::memory_order_relaxed);
+			if (motionplatform::ReplayPlayer *replay = m_platform->replay.get()) {
+				m_stats.replayPrefetched.store(replay->prefetched(), boost::memory_order_relaxed);
+				m_stats.replayMisses.store(replay->misses(), boost::memory_order_relaxed);
+			}
+		}
+
+		/*
+		 * Take the settings of @p config that can change while running
+		 */
+		void applyConfig(motionplatform::Config const &config) {
+			m_period = tickPeriod(config.rateHz);
+			m_analogCount = config.sequence ? Layout::ANALOG_COUNT : Layout::SEQUENCE_CHANNEL;
+		}
+
+		/*
+		 * Pick up a new config; the descriptor is only resent when its
+		 * serialized form actually changed
+		 */
+		void reconfigure() {
+			m_configGeneration = m_platform->config->generation();
+			motionplatform::ConfigStore::ConfigPtr config = m_platform->config->get();
+			applyConfig(*config);
+			if (m_seat == 0) {
+				/// the workers are idle between ticks, so the first seat can
+				/// swap what drives the channels before it runs the next one
+				assignScripts(*m_platform->scripts, m_sim->seatCount(), *config, m_motionConfig.get());
+				setReplay(*m_platform, *config, m_motionConfig.get());
+				if (config->noise != m_motionConfig->noise || config->rateHz != m_motionConfig->rateHz) {
+					setNoise(*m_platform, *config);
+				}
+				if (config->channelSignals != m_motionConfig->channelSignals) {
+					setSignals(*m_platform, *config);
+				}
+				if (config->vibration != m_motionConfig->vibration || config->rateHz != m_motionConfig->rateHz) {
+					setVibration(*m_platform, *config);
+				}
+				if (config->channelExpressions != m_motionConfig->channelExpressions) {
+					setExpressions(*m_platform, *config);
+				}
+				m_motionConfig = config;
+			}
+			std::string descriptor = motionplatform::buildDescriptor(*config, m_seat);
+			if (descriptor != m_descriptor) {
+				m_descriptor.swap(descriptor);
+				m_dev.sendJsonDescriptor(m_descriptor);
+				if (motionplatform::CallLogWriter *calls = m_platform->calls.get()) {
+					calls->descriptor(m_seat, m_descriptor.data(), m_descriptor.size());
+				}
+			}
+		}
+
+		/*
+		 * First seat keeps the historical device name, others get a suffix
+		 */
+		static std::string deviceName(std::size_t seat) {
+			std::string name("SyncMotionPlatformDevice");
+			if (seat > 0) {
+				name += boost::lexical_cast<std::string>(seat);
+			}
+			return name;
 		}
 	};
 
+	typedef TrackerSyncDevice<motionplatform::generated::DescriptorLayout> MotionPlatformDevice;
+
+	/// @brief State shared by the detection and driver instantiation callbacks
+	struct PluginState {
+		explicit PluginState(motionplatform::Config const &defaults)
+			: created(false), config(boost::make_shared<motionplatform::ConfigStore>(defaults)) {}
+
+		/// @brief Have the devices been created yet? (this limits the plugin to
+		/// one instance)
+		bool created;
+		motionplatform::ConfigStorePtr config;
+	};
+	typedef boost::shared_ptr<PluginState> PluginStatePtr;
+
+	/*
+	 * Serve the platform's counters on localhost, if a port was given
+	 */
+	void startExporter(Platform &platform, unsigned short metricsPort) {
+		if (!metricsPort) {
+			return;
+		}
+		try {
+			platform.exporter.reset(new motionplatform::StatsExporter(platform.stats, metricsPort));
+			std::cout << "MPS_PLUGIN > Serving metrics on 127.0.0.1:" << metricsPort << std::endl;
+		} catch (boost::system::system_error const &e) {
+			std::cerr << "MPS_PLUGIN > Could not serve metrics: " << e.what() << std::endl;
+		}
+	}
+
+	/*
+	 * Record a phase timeline to a file, if one was given
+	 */
+	void startTrace(Platform &platform, motionplatform::Simulation &sim, std::string const &traceFile) {
+		if (traceFile.empty()) {
+			return;
+		}
+		platform.trace.reset(new motionplatform::Trace(traceFile));
+		if (!platform.trace->isOpen()) {
+			std::cerr << "MPS_PLUGIN > Could not open trace file " << traceFile << std::endl;
+			platform.trace.reset();
+			return;
+		}
+		sim.setTrace(platform.trace.get());
+		std::cout << "MPS_PLUGIN > Tracing tick phases to " << traceFile << std::endl;
+	}
+
+	/*
+	 * Log every device call to a file, if one was given
+	 */
+	void startCapture(Platform &platform, std::string const &captureFile) {
+		if (captureFile.empty()) {
+			return;
+		}
+		platform.calls.reset(new motionplatform::CallLogWriter(captureFile));
+		if (!platform.calls->isOpen()) {
+			std::cerr << "MPS_PLUGIN > Could not open capture file " << captureFile << std::endl;
+			platform.calls.reset();
+			return;
+		}
+		std::cout << "MPS_PLUGIN > Capturing device calls to " << captureFile << std::endl;
+	}
+
+	/*
+	 * Build the shared simulation and everything that drives its channels as
+	 * @p config describes them, then let the seats start; runs on the
+	 * platform's warmup thread, @p start is when registration began
+	 */
+	void warmUp(Platform &platform, motionplatform::ConfigStore::ConfigPtr const &config, Clock::time_point start) {
+		try {
+			motionplatform::SimulationPtr sim = boost::make_shared<motionplatform::Simulation>(config->seats);
+			startTrace(platform, *sim, config->traceFile);
+			platform.scripts.reset(new motionplatform::ScriptPlayer(config->seats, sim->maxAngle()));
+			assignScripts(*platform.scripts, config->seats, *config, NULL);
+			sim->setScripts(platform.scripts.get());
+			platform.scheduler = boost::make_shared<motionplatform::Scheduler>(sim, config->workers);
+			setNoise(platform, *config);
+			setReplay(platform, *config, NULL);
+			setSignals(platform, *config);
+			setVibration(platform, *config);
+			setExpressions(platform, *config);
+		} catch (std::exception const &e) {
+			std::cerr << "MPS_PLUGIN > Could not warm up: " << e.what() << std::endl;
+			return;
+		}
+		platform.ready.store(true, boost::memory_order_release);
+		const double usec = toUsec(Clock::now() - start);
+		platform.stats->readyUsec.store(static_cast<boost::uint64_t>(usec), boost::memory_order_relaxed);
+		platform.stats->warmingUp.store(0, boost::memory_order_relaxed);
+		std::cout << "MPS_PLUGIN > Ready after " << usec / 1000.0 << " ms" << std::endl;
+	}
+
+	/*
+	 * Register one device object per seat, as the current config describes
+	 * them, and build the shared simulation behind them in the background so
+	 * the server is not held up
+	 */
+	void createDevices(OSVR_PluginRegContext ctx, PluginState &state) {
+		const Clock::time_point start = Clock::now();
+		state.created = true;
+		motionplatform::ConfigStore::ConfigPtr config = state.config->get();
+		PlatformPtr platform = boost::make_shared<Platform>();
+		platform->config = state.config;
+		startCapture(*platform, config->captureFile);
+		platform->stats = boost::make_shared<motionplatform::Stats>();
+		platform->stats->seats.store(config->seats);
+		platform->stats->warmingUp.store(1);
+		startExporter(*platform, config->metricsPort);
+		for (std::size_t seat = 0; seat < config->seats; ++seat) {
+			osvr::pluginkit::registerObjectForDeletion(ctx, new MotionPlatformDevice(ctx, platform, seat));
+		}
+		const double usec = toUsec(Clock::now() - start);
+		platform->stats->registerUsec.store(static_cast<boost::uint64_t>(usec), boost::memory_order_relaxed);
+		std::cout << "MPS_PLUGIN > Registered " << config->seats << " seats in " << usec / 1000.0
+			<< " ms, warming up" << std::endl;
+		/// the platform outlives the thread: its destructor joins it
+		platform->warmup = boost::thread(boost::bind(&warmUp, boost::ref(*platform), config, start));
+	}
+
 	class HardwareDetection {
 	public:
-		HardwareDetection() : m_found(false) {}
+		explicit HardwareDetection(PluginStatePtr const &state) : m_state(state) {}
 		OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
 #ifdef _DEBUG
 			std::cout << "MPS_PLUGIN > Got a hardware detection request" << std::endl;
 #endif
-			if (!m_found) {
+			if (!m_state->created) {
 				std::cout << "MPS_PLUGIN > We have detected our fake motion platform device - Starting setup !" << std::endl;
-				m_found = true;
-				/// Create our device object
-				osvr::pluginkit::registerObjectForDeletion(ctx, new TrackerSyncDevice(ctx));
+				createDevices(ctx, *m_state);
+			}
+			return OSVR_RETURN_SUCCESS;
+		}
+
+	private:
+		PluginStatePtr m_state;
+	};
+
+	/// @brief Handles a "MotionPlatform" entry in the server's "drivers" list.
+	///
+	/// Its "params" are read over the current config. Before the devices exist
+	/// this creates them; afterwards the config is published to the running
+	/// seats, which pick it up on their next update (seats, workers, metrics,
+	/// tracing and capture are fixed once created). A seat whose script changes starts
+	/// the new one from rest.
+	class DriverInstantiation {
+	public:
+		explicit DriverInstantiation(PluginStatePtr const &state) : m_state(state) {}
+		OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx, const char *params) {
+			motionplatform::Config config = *m_state->config->get();
+			std::string error;
+			if (params && !motionplatform::loadConfig(params, config, error)) {
+				std::cerr << "MPS_PLUGIN > Invalid driver params: " << error << std::endl;
+				return OSVR_RETURN_FAILURE;
+			}
+			m_state->config->set(config);
+			if (!m_state->created) {
+				std::cout << "MPS_PLUGIN > Creating motion platform from the server config" << std::endl;
+				createDevices(ctx, *m_state);
 			}
 			return OSVR_RETURN_SUCCESS;
 		}
 
 	private:
-		/// @brief Have we found our device yet? (this limits the plugin to one
-		/// instance)
-		bool m_found;
+		PluginStatePtr m_state;
 	};
 } // namespace
 
 OSVR_PLUGIN(com_vectionvr_osvr_motionPlatformDevicePlugin) {
 	osvr::pluginkit::PluginContext context(ctx);
 
+	motionplatform::Config defaults;
+	/// Metrics are opt-in: set MPS_METRICS_PORT to serve them on localhost
+	if (const char *metricsPort = std::getenv("MPS_METRICS_PORT")) {
+		/// digits only, so "-1" or "70000" cannot wrap to some other port
+		char *end = NULL;
+		const unsigned long port = std::strtoul(metricsPort, &end, 10);
+		if (std::isdigit(static_cast<unsigned char>(metricsPort[0])) && *end == '\0' && port <= 65535) {
+			defaults.metricsPort = static_cast<unsigned short>(port);
+		} else {
+			std::cerr << "MPS_PLUGIN > Ignoring MPS_METRICS_PORT=\"" << metricsPort
+				<< "\": not a port number from 0 to 65535" << std::endl;
+		}
+	}
+	/// Tick phase tracing likewise: MPS_TRACE_FILE names the JSON output
+	if (const char *traceFile = std::getenv("MPS_TRACE_FILE")) {
+		defaults.traceFile = traceFile;
+	}
+	/// Device call capture likewise: MPS_CAPTURE_FILE names the log
+	if (const char *captureFile = std::getenv("MPS_CAPTURE_FILE")) {
+		defaults.captureFile = captureFile;
+	}
+	PluginStatePtr state = boost::make_shared<PluginState>(defaults);
+
 	/// Register a detection callback function object.
-	context.registerHardwareDetectCallback(new HardwareDetection());
+	context.registerHardwareDetectCallback(new HardwareDetection(state));
+	/// Driver params from the server config override the defaults above
+	context.registerDriverInstantiationCallback("MotionPlatform", DriverInstantiation(state));
 
 	return OSVR_RETURN_SUCCESS;
 }